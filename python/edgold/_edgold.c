@@ -0,0 +1,367 @@
+/**
+ * @file _edgold.c
+ * @copyright
+ *   Copyright (c) 2018 the libgoldilocks contributors.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ *
+ * @brief Compiled fast path for the edgold Python wrapper.
+ *
+ * Arguments are taken through the buffer protocol without copying, the
+ * GIL is released around the library calls, and the *_many functions
+ * run their whole loop in C.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <string.h>
+#include <goldilocks/ed448.h>
+#include <goldilocks/point_448.h>
+
+#define PUB_BYTES  GOLDILOCKS_EDDSA_448_PUBLIC_BYTES
+#define PRIV_BYTES GOLDILOCKS_EDDSA_448_PRIVATE_BYTES
+#define SIG_BYTES  GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES
+#define X_BYTES    GOLDILOCKS_X448_PUBLIC_BYTES
+
+/**
+ * A batch argument.  It is either a list or tuple with one buffer per
+ * item, or a single buffer which holds the items back to back, or a
+ * single item which is used for every element of the batch.
+ */
+typedef struct {
+    Py_buffer *views;
+    Py_ssize_t nviews;
+    Py_ssize_t n;           /* number of items, or -1 if shared by all */
+    Py_ssize_t item_len;    /* length of each item in a contiguous buffer */
+} batch_t;
+
+static void batch_release(batch_t *b) {
+    Py_ssize_t i;
+    for (i=0; i<b->nviews; i++) PyBuffer_Release(&b->views[i]);
+    PyMem_Free(b->views);
+    b->views = NULL;
+    b->nviews = 0;
+}
+
+/**
+ * Parse a batch argument.  If fixed_len is nonzero every item must have
+ * that length.  item_len splits a single buffer into items; if it is 0,
+ * a single buffer is one item shared by the whole batch.
+ */
+static int batch_parse(
+    batch_t *b,
+    PyObject *obj,
+    const char *name,
+    Py_ssize_t fixed_len,
+    Py_ssize_t item_len
+) {
+    Py_ssize_t i;
+    memset(b, 0, sizeof(*b));
+
+    if (PyList_Check(obj) || PyTuple_Check(obj)) {
+        PyObject *seq = PySequence_Fast(obj, name);
+        if (seq == NULL) return -1;
+        b->n = PySequence_Fast_GET_SIZE(seq);
+        b->views = PyMem_Calloc(b->n ? b->n : 1, sizeof(Py_buffer));
+        if (b->views == NULL) {
+            Py_DECREF(seq);
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (i=0; i<b->n; i++) {
+            if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(seq, i), &b->views[i], PyBUF_SIMPLE) < 0) {
+                Py_DECREF(seq);
+                batch_release(b);
+                return -1;
+            }
+            b->nviews++;
+            if (fixed_len && b->views[i].len != fixed_len) {
+                Py_DECREF(seq);
+                batch_release(b);
+                PyErr_Format(PyExc_ValueError, "%s[%zd] must be %zd bytes", name, i, fixed_len);
+                return -1;
+            }
+        }
+        Py_DECREF(seq);
+        return 0;
+    }
+
+    b->views = PyMem_Calloc(1, sizeof(Py_buffer));
+    if (b->views == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (PyObject_GetBuffer(obj, &b->views[0], PyBUF_SIMPLE) < 0) {
+        batch_release(b);
+        return -1;
+    }
+    b->nviews = 1;
+
+    if (item_len == 0 || b->views[0].len == item_len) {
+        b->n = -1;
+    } else if (b->views[0].len % item_len == 0) {
+        b->n = b->views[0].len / item_len;
+        b->item_len = item_len;
+    } else {
+        batch_release(b);
+        PyErr_Format(PyExc_ValueError, "%s must be a list or a multiple of %zd bytes", name, item_len);
+        return -1;
+    }
+    if (fixed_len && b->n < 0 && b->views[0].len != fixed_len) {
+        batch_release(b);
+        PyErr_Format(PyExc_ValueError, "%s must be %zd bytes", name, fixed_len);
+        return -1;
+    }
+    return 0;
+}
+
+static const unsigned char *batch_item(const batch_t *b, Py_ssize_t i, size_t *len) {
+    if (b->item_len) {
+        if (len) *len = b->item_len;
+        return (const unsigned char *)b->views[0].buf + i*b->item_len;
+    }
+    i = (b->n < 0) ? 0 : i;
+    if (len) *len = b->views[i].len;
+    return (const unsigned char *)b->views[i].buf;
+}
+
+/** Agree on a batch size; shared items fit any size.  Returns -1 on mismatch. */
+static Py_ssize_t batch_size(batch_t *const *bs, int nb) {
+    Py_ssize_t n = -1;
+    int i;
+    for (i=0; i<nb; i++) {
+        if (bs[i]->n < 0) continue;
+        if (n >= 0 && n != bs[i]->n) {
+            PyErr_SetString(PyExc_ValueError, "batch arguments have different lengths");
+            return -1;
+        }
+        n = bs[i]->n;
+    }
+    return (n < 0) ? 1 : n;
+}
+
+static int get_context(Py_buffer *view, PyObject *ctx) {
+    memset(view, 0, sizeof(*view));
+    if (ctx == NULL || ctx == Py_None) return 0;
+    if (PyObject_GetBuffer(ctx, view, PyBUF_SIMPLE) < 0) return -1;
+    if (view->len > 255) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_ValueError, "ctx must be at most 255 bytes");
+        return -1;
+    }
+    return 0;
+}
+
+static void release_context(Py_buffer *view) {
+    if (view->obj) PyBuffer_Release(view);
+}
+
+static PyObject *bytes_list(const unsigned char *out, Py_ssize_t n, size_t size, const goldilocks_bool_t *ok) {
+    PyObject *ret = PyList_New(n);
+    Py_ssize_t i;
+    if (ret == NULL) return NULL;
+    for (i=0; i<n; i++) {
+        PyObject *item;
+        if (ok && !ok[i]) {
+            Py_INCREF(Py_None);
+            item = Py_None;
+        } else if ((item = PyBytes_FromStringAndSize((const char *)out + i*size, size)) == NULL) {
+            Py_DECREF(ret);
+            return NULL;
+        }
+        PyList_SET_ITEM(ret, i, item);
+    }
+    return ret;
+}
+
+PyDoc_STRVAR(derive_public_key_doc,
+"derive_public_key(priv) -> bytes\n\nDerive the Ed448 public key for a private key.");
+
+static PyObject *edgold_derive_public_key(PyObject *self, PyObject *args) {
+    Py_buffer priv;
+    unsigned char pub[PUB_BYTES];
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "y*:derive_public_key", &priv)) return NULL;
+    if (priv.len != PRIV_BYTES) {
+        PyBuffer_Release(&priv);
+        return PyErr_Format(PyExc_ValueError, "priv must be %d bytes", PRIV_BYTES);
+    }
+    Py_BEGIN_ALLOW_THREADS
+    goldilocks_ed448_derive_public_key(pub, priv.buf);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&priv);
+    return PyBytes_FromStringAndSize((const char *)pub, sizeof(pub));
+}
+
+PyDoc_STRVAR(sign_many_doc,
+"sign_many(priv, pub, msgs, ctx=None, msglen=0) -> list of bytes\n\n"
+"Sign a batch of messages.  msgs is a list of buffers, or one buffer of\n"
+"messages msglen bytes long each.  priv and pub are either a single key\n"
+"or one key per message, as a list or as one buffer of keys.");
+
+static PyObject *edgold_sign_many(PyObject *self, PyObject *args, PyObject *kw) {
+    static char *kwlist[] = { "priv", "pub", "msgs", "ctx", "msglen", NULL };
+    PyObject *priv_o, *pub_o, *msgs_o, *ctx_o = NULL, *ret = NULL;
+    Py_ssize_t msglen = 0, n, i;
+    batch_t priv, pub, msgs;
+    batch_t *all[3] = { &priv, &pub, &msgs };
+    Py_buffer ctx;
+    unsigned char *out;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOO|On:sign_many", kwlist,
+            &priv_o, &pub_o, &msgs_o, &ctx_o, &msglen)) return NULL;
+    if (msglen < 0) return PyErr_Format(PyExc_ValueError, "msglen must not be negative");
+    if (get_context(&ctx, ctx_o) < 0) return NULL;
+    if (batch_parse(&priv, priv_o, "priv", PRIV_BYTES, PRIV_BYTES) < 0) goto fail_ctx;
+    if (batch_parse(&pub, pub_o, "pub", PUB_BYTES, PUB_BYTES) < 0) goto fail_priv;
+    if (batch_parse(&msgs, msgs_o, "msgs", 0, msglen) < 0) goto fail_pub;
+    if ((n = batch_size(all, 3)) < 0) goto fail_msgs;
+
+    if ((out = PyMem_Malloc(n*SIG_BYTES + 1)) == NULL) {
+        PyErr_NoMemory();
+        goto fail_msgs;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    for (i=0; i<n; i++) {
+        size_t len;
+        const unsigned char *msg = batch_item(&msgs, i, &len);
+        goldilocks_ed448_sign(out + i*SIG_BYTES, batch_item(&priv, i, NULL), batch_item(&pub, i, NULL),
+            msg, len, 0, ctx.buf, (uint8_t)ctx.len);
+    }
+    Py_END_ALLOW_THREADS
+    ret = bytes_list(out, n, SIG_BYTES, NULL);
+    PyMem_Free(out);
+
+fail_msgs:
+    batch_release(&msgs);
+fail_pub:
+    batch_release(&pub);
+fail_priv:
+    batch_release(&priv);
+fail_ctx:
+    release_context(&ctx);
+    return ret;
+}
+
+PyDoc_STRVAR(verify_many_doc,
+"verify_many(sigs, pub, msgs, ctx=None, msglen=0) -> list of bool\n\n"
+"Verify a batch of signatures.  Each argument is either a single item\n"
+"or one per signature, as a list or as one buffer of fixed-size items.");
+
+static PyObject *edgold_verify_many(PyObject *self, PyObject *args, PyObject *kw) {
+    static char *kwlist[] = { "sigs", "pub", "msgs", "ctx", "msglen", NULL };
+    PyObject *sigs_o, *pub_o, *msgs_o, *ctx_o = NULL, *ret = NULL;
+    Py_ssize_t msglen = 0, n, i;
+    batch_t sigs, pub, msgs;
+    batch_t *all[3] = { &sigs, &pub, &msgs };
+    Py_buffer ctx;
+    goldilocks_bool_t *ok;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOO|On:verify_many", kwlist,
+            &sigs_o, &pub_o, &msgs_o, &ctx_o, &msglen)) return NULL;
+    if (msglen < 0) return PyErr_Format(PyExc_ValueError, "msglen must not be negative");
+    if (get_context(&ctx, ctx_o) < 0) return NULL;
+    if (batch_parse(&sigs, sigs_o, "sigs", SIG_BYTES, SIG_BYTES) < 0) goto fail_ctx;
+    if (batch_parse(&pub, pub_o, "pub", PUB_BYTES, PUB_BYTES) < 0) goto fail_sigs;
+    if (batch_parse(&msgs, msgs_o, "msgs", 0, msglen) < 0) goto fail_pub;
+    if ((n = batch_size(all, 3)) < 0) goto fail_msgs;
+
+    if ((ok = PyMem_Malloc(n*sizeof(*ok) + 1)) == NULL) {
+        PyErr_NoMemory();
+        goto fail_msgs;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    for (i=0; i<n; i++) {
+        size_t len;
+        const unsigned char *msg = batch_item(&msgs, i, &len);
+        ok[i] = goldilocks_successful(goldilocks_ed448_verify(batch_item(&sigs, i, NULL),
+            batch_item(&pub, i, NULL), msg, len, 0, ctx.buf, (uint8_t)ctx.len));
+    }
+    Py_END_ALLOW_THREADS
+    if ((ret = PyList_New(n)) != NULL) {
+        for (i=0; i<n; i++) {
+            PyObject *b = ok[i] ? Py_True : Py_False;
+            Py_INCREF(b);
+            PyList_SET_ITEM(ret, i, b);
+        }
+    }
+    PyMem_Free(ok);
+
+fail_msgs:
+    batch_release(&msgs);
+fail_pub:
+    batch_release(&pub);
+fail_sigs:
+    batch_release(&sigs);
+fail_ctx:
+    release_context(&ctx);
+    return ret;
+}
+
+PyDoc_STRVAR(x448_many_doc,
+"x448_many(pub, priv) -> list of bytes or None\n\n"
+"RFC 7748 X448 for a batch of public and private keys, each either a\n"
+"single key or one per element.  Elements whose result is the all-zero\n"
+"string (a low-order public key) come back as None.");
+
+static PyObject *edgold_x448_many(PyObject *self, PyObject *args) {
+    PyObject *pub_o, *priv_o, *ret = NULL;
+    Py_ssize_t n, i;
+    batch_t pub, priv;
+    batch_t *all[2] = { &pub, &priv };
+    unsigned char *out;
+    goldilocks_bool_t *ok;
+    (void)self;
+
+    if (!PyArg_ParseTuple(args, "OO:x448_many", &pub_o, &priv_o)) return NULL;
+    if (batch_parse(&pub, pub_o, "pub", X_BYTES, X_BYTES) < 0) return NULL;
+    if (batch_parse(&priv, priv_o, "priv", GOLDILOCKS_X448_PRIVATE_BYTES, GOLDILOCKS_X448_PRIVATE_BYTES) < 0) goto fail_pub;
+    if ((n = batch_size(all, 2)) < 0) goto fail_priv;
+
+    out = PyMem_Malloc(n*X_BYTES + 1);
+    ok = PyMem_Malloc(n*sizeof(*ok) + 1);
+    if (out == NULL || ok == NULL) {
+        PyMem_Free(out);
+        PyMem_Free(ok);
+        PyErr_NoMemory();
+        goto fail_priv;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    for (i=0; i<n; i++) {
+        ok[i] = goldilocks_successful(goldilocks_x448(out + i*X_BYTES,
+            batch_item(&pub, i, NULL), batch_item(&priv, i, NULL)));
+    }
+    Py_END_ALLOW_THREADS
+    ret = bytes_list(out, n, X_BYTES, ok);
+    goldilocks_bzero(out, n*X_BYTES);
+    PyMem_Free(out);
+    PyMem_Free(ok);
+
+fail_priv:
+    batch_release(&priv);
+fail_pub:
+    batch_release(&pub);
+    return ret;
+}
+
+static PyMethodDef edgold_methods[] = {
+    { "derive_public_key", edgold_derive_public_key, METH_VARARGS, derive_public_key_doc },
+    { "sign_many", (PyCFunction)(void(*)(void))edgold_sign_many, METH_VARARGS | METH_KEYWORDS, sign_many_doc },
+    { "verify_many", (PyCFunction)(void(*)(void))edgold_verify_many, METH_VARARGS | METH_KEYWORDS, verify_many_doc },
+    { "x448_many", edgold_x448_many, METH_VARARGS, x448_many_doc },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef edgold_module = {
+    PyModuleDef_HEAD_INIT,
+    "_edgold",
+    "Compiled batch entry points for edgold.",
+    -1,
+    edgold_methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit__edgold(void) {
+    return PyModule_Create(&edgold_module);
+}
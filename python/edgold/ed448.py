@@ -58,6 +58,13 @@ except OSError as e: # pragma: no cover
 	warnings.warn('libgoldilocks.so not installed.')
 	raise ImportError(str(e))
 
+# The compiled module takes buffers without copying, releases the GIL,
+# and provides the *_many batch calls.  The ctypes path is the fallback.
+try:
+	from . import _edgold
+except ImportError: # pragma: no cover
+	_edgold = None
+
 GOLDILOCKS_EDDSA_448_PUBLIC_BYTES = 57
 GOLDILOCKS_EDDSA_448_PRIVATE_BYTES = GOLDILOCKS_EDDSA_448_PUBLIC_BYTES
 GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES = GOLDILOCKS_EDDSA_448_PUBLIC_BYTES + GOLDILOCKS_EDDSA_448_PRIVATE_BYTES
@@ -94,12 +101,8 @@ def _makeba(s):
 	return r
 
 def _makestr(a):
-	# XXX - because python3 sucks, and unittest doesn't offer
-	# ability to silence stupid warnings, hide the tostring
-	# DeprecationWarning.
-	with warnings.catch_warnings():
-		warnings.simplefilter('ignore')
-		return array.array('B', a).tostring()
+	# array.tostring is gone in python 3.9; this works everywhere.
+	return bytes(bytearray(a))
 
 
 def _ed448_privkey():
@@ -185,6 +188,9 @@ class EDDSA448(object):
 	def sign(self, msg, ctx=None):
 		'''Returns a signature over the message.  Requires that has_private returns True.'''
 
+		if _edgold is not None:
+			return _edgold.sign_many(self._priv, self._pub, [ msg ], ctx)[0]
+
 		sig = ed448_sig_t()
 		ctxargs = self._makectxargs(ctx)
 		goldilocks.goldilocks_ed448_sign(sig, self._priv, self._pub, _makeba(msg), len(msg), 0, *ctxargs)
@@ -194,15 +200,39 @@ class EDDSA448(object):
 	def verify(self, sig, msg, ctx=None):
 		'''Raises an error if sig is not valid for msg.'''
 
+		if _edgold is not None:
+			if not _edgold.verify_many([ sig ], self._pub, [ msg ], ctx)[0]:
+				raise ValueError('signature is not valid')
+			return
+
 		_sig = ed448_sig_t()
 		_sig[:] = array.array('B', sig)
 		ctxargs = self._makectxargs(ctx)
 		if not goldilocks.goldilocks_ed448_verify(_sig, self._pub, _makeba(msg), len(msg), 0, *ctxargs):
 			raise ValueError('signature is not valid')
 
+	def sign_many(self, msgs, ctx=None, msglen=0):
+		'''Returns a list of signatures, one per message.  msgs is
+		a list of byte strings, or a single buffer holding messages
+		of msglen bytes each.  Requires the compiled module.'''
+
+		return _edgold.sign_many(self._priv, self._pub, msgs, ctx, msglen)
+
+	def verify_many(self, sigs, msgs, ctx=None, msglen=0):
+		'''Returns a list of bools, one per signature.  sigs is a
+		list of signatures, or a single buffer of them back to back;
+		msgs is as for sign_many.  Requires the compiled module.'''
+
+		return _edgold.verify_many(sigs, self._pub, msgs, ctx, msglen)
+
 def generate(curve='ed448'):
 	return EDDSA448.generate()
 
+if _edgold is not None:
+	sign_many = _edgold.sign_many
+	verify_many = _edgold.verify_many
+	x448_many = _edgold.x448_many
+
 class TestEd448(unittest.TestCase):
 	def test_init(self):
 		self.assertRaises(ValueError, EDDSA448)
@@ -286,6 +316,43 @@ class TestEd448(unittest.TestCase):
 		# Make sure it fails w/ invalid/different context
 		self.assertRaises(ValueError, key.verify, sig, message, ctx + b'a')
 
+	@unittest.skipIf(_edgold is None, 'compiled module not built')
+	def test_many(self):
+		keys = [ generate() for x in range(3) ]
+		msgs = [ b'message %d' % x for x in range(3) ]
+
+		sigs = keys[0].sign_many(msgs, b'ctx')
+		self.assertEqual(sigs, [ keys[0].sign(m, b'ctx') for m in msgs ])
+		self.assertEqual(keys[0].verify_many(sigs, msgs, b'ctx'), [ True ] * 3)
+		self.assertEqual(keys[0].verify_many(sigs, msgs), [ False ] * 3)
+
+		# contiguous buffers, one key per message
+		privs = b''.join(k.export_key('raw') for k in keys)
+		pubs = b''.join(k.public_key().export_key('raw') for k in keys)
+		sigs = sign_many(privs, pubs, memoryview(b''.join(msgs)), msglen=len(msgs[0]))
+		for k, s, m in zip(keys, sigs, msgs):
+			k.verify(s, m)
+		sigs[1] = sigs[0]
+		self.assertEqual(verify_many(b''.join(sigs), pubs, msgs), [ True, False, True ])
+
+		self.assertRaises(ValueError, sign_many, privs, pubs[:-1], msgs)
+		self.assertRaises(ValueError, verify_many, sigs, pubs, msgs[:2])
+		self.assertRaises(ValueError, keys[0].sign_many, msgs, b'c' * 256)
+		self.assertRaises(ValueError, sign_many, privs, pubs, b'x' * 10, msglen=-5)
+		self.assertRaises(ValueError, verify_many, sigs, pubs, b'x' * 10, msglen=-5)
+
+	@unittest.skipIf(_edgold is None, 'compiled module not built')
+	def test_x448_many(self):
+		# RFC 7748, section 6.2
+		a = bytes.fromhex('9a8f4925d1519f5775cf46b04b5800d4ee9ee8bae8bc5565d498c28dd9c9baf574a9419744897391006382a6f127ab1d9ac2d8c0a598726b')
+		b = bytes.fromhex('1c306a7ac2a0e2e0990b294470cba339e6453772b075811d8fad0d1d6927c120bb5ee8972b0d3e21374c9c921b09d1b0366f10b65173992d')
+		k = bytes.fromhex('07fff4181ac6cc95ec1c16a94a0f74d12da232ce40a77552281d282bb60c0b56fd2464c335543936521c24403085d59a449a5037514a879d')
+		base = b'\x05' + b'\x00' * 55
+
+		pubs = x448_many(base, [ a, b ])
+		self.assertEqual(x448_many(pubs[::-1], [ a, b ]), [ k, k ])
+		self.assertEqual(x448_many(b'\x00' * 56, a), [ None ])
+
 class TestBasicLib(unittest.TestCase):
 	def test_basic(self):
 		priv = _ed448_privkey()
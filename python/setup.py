@@ -27,15 +27,17 @@
 #
 
 from distutils.command.build import build
-from distutils.core import setup
+from distutils.core import setup, Extension
 
 import os
 
 class my_build(build):
     def run(self):
-        build.run(self)
+        # The extension links against the library, so build it first.
         if not self.dry_run:
             os.spawnlp(os.P_WAIT, 'sh', 'sh', '-c', 'cd .. && gmake lib')
+        build.run(self)
+        if not self.dry_run:
             self.copy_file(os.path.join('..', 'build', 'lib', 'libgoldilocks.so'), os.path.join(self.build_lib, 'edgold'))
 
 cmdclass = {}
@@ -49,4 +51,11 @@ setup(name='edgold',
       #url='',
       cmdclass=cmdclass,
       packages=['edgold', ],
+      ext_modules=[
+          Extension('edgold._edgold', ['edgold/_edgold.c'],
+              include_dirs=[os.path.join('..', 'src', 'public_include')],
+              library_dirs=[os.path.join('..', 'build', 'lib')],
+              libraries=['goldilocks'],
+              runtime_library_dirs=['$ORIGIN']),
+      ],
      )
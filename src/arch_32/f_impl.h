@@ -3,6 +3,24 @@
  */
 
 #define GF_HEADROOM 2
+
+/* gf_mul forms a[i]+a[i+8] in 32 bits, so inputs may reach bound 7; its
+ * 64-bit accumulators hold at most 39 products of input limbs, which stays
+ * below 2^64 while the bounds multiply to at most 6.
+ */
+#define GF_LIMB_BOUND 6
+#define GF_MUL_BOUND 6
+
+/* f_vec2.h provides 2-way field ops for the X448 ladder */
+#if defined(__SSE2__) && !defined(GOLDILOCKS_NO_VEC2)
+#define GF_HAVE_VEC2 1
+#endif
+
+/* f_vec4.h provides 4-way field ops for the Edwards formulas */
+#if defined(__AVX2__) && !defined(GOLDILOCKS_NO_VEC4)
+#define GF_HAVE_VEC4 1
+#endif
+
 #define LIMB(x) (x##ull)&((1ull<<28)-1), (x##ull)>>28
 #define FIELD_LITERAL(a,b,c,d,e,f,g,h) \
     {{LIMB(a),LIMB(b),LIMB(c),LIMB(d),LIMB(e),LIMB(f),LIMB(g),LIMB(h)}}
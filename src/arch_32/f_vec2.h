@@ -0,0 +1,165 @@
+/* Copyright (c) 2018 the libgoldilocks contributors.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+/*
+ * Pairs of field elements for the X448 ladder, one in each 64-bit lane of
+ * an SSE2 vector, so that two independent multiplications run as one.  Each
+ * lane holds a limb as in f_impl.c, and gf2_mul follows gf_mul exactly, so
+ * the bounds of GF_MUL_BOUND apply lane by lane.
+ */
+
+#ifndef __ARCH_32_F_VEC2_H__
+#define __ARCH_32_F_VEC2_H__ 1
+
+#include <emmintrin.h>
+
+typedef struct gf2_s {
+    __m128i limb[16];
+} gf2_s, gf2[1];
+
+/** out = (lo, hi) */
+static GOLDILOCKS_INLINE void gf2_pack(gf2 out, const gf lo, const gf hi) {
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        out->limb[i] = _mm_set_epi32(0, hi->limb[i], 0, lo->limb[i]);
+    }
+}
+
+/** out = in.lo */
+static GOLDILOCKS_INLINE void gf2_lo(gf out, const gf2 in) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_cvtsi128_si32(in->limb[i]);
+}
+
+/** out = (a.lo, b.lo) */
+static GOLDILOCKS_INLINE void gf2_lo_lo(gf2 out, const gf2 a, const gf2 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_unpacklo_epi64(a->limb[i], b->limb[i]);
+}
+
+/** out = (a.hi, b.hi) */
+static GOLDILOCKS_INLINE void gf2_hi_hi(gf2 out, const gf2 a, const gf2 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_unpackhi_epi64(a->limb[i], b->limb[i]);
+}
+
+/** out = (a.hi, a.lo) */
+static GOLDILOCKS_INLINE void gf2_swap_lanes(gf2 out, const gf2 a) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_shuffle_epi32(a->limb[i], 0x4E);
+}
+
+/** Constant time, if (swap) a = (a.hi, a.lo) */
+static GOLDILOCKS_INLINE void gf2_cond_swap_lanes(gf2 a, mask_t swap) {
+    __m128i m = _mm_set1_epi32(swap);
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        __m128i x = _mm_xor_si128(a->limb[i], _mm_shuffle_epi32(a->limb[i], 0x4E));
+        a->limb[i] = _mm_xor_si128(a->limb[i], _mm_and_si128(x, m));
+    }
+}
+
+static GOLDILOCKS_INLINE void gf2_add_RAW(gf2 out, const gf2 a, const gf2 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_add_epi64(a->limb[i], b->limb[i]);
+}
+
+static GOLDILOCKS_INLINE void gf2_sub_RAW(gf2 out, const gf2 a, const gf2 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm_sub_epi64(a->limb[i], b->limb[i]);
+}
+
+static GOLDILOCKS_INLINE void gf2_bias(gf2 a, int amt) {
+    uint32_t co1 = ((1ull<<28)-1)*amt, co2 = co1-amt;
+    __m128i lo = _mm_set1_epi64x(co1), hi = _mm_set1_epi64x(co2);
+    unsigned int i;
+    for (i=0; i<16; i++) a->limb[i] = _mm_add_epi64(a->limb[i], (i==8) ? hi : lo);
+}
+
+static GOLDILOCKS_INLINE void gf2_weak_reduce(gf2 a) {
+    __m128i mask = _mm_set1_epi64x((1ull<<28)-1);
+    __m128i tmp = _mm_srli_epi64(a->limb[15], 28);
+    unsigned int i;
+    a->limb[8] = _mm_add_epi64(a->limb[8], tmp);
+    for (i=15; i>0; i--) {
+        a->limb[i] = _mm_add_epi64(_mm_and_si128(a->limb[i], mask), _mm_srli_epi64(a->limb[i-1], 28));
+    }
+    a->limb[0] = _mm_add_epi64(_mm_and_si128(a->limb[0], mask), tmp);
+}
+
+/** Lane-wise gf_mul */
+static void gf2_mul(gf2_s *__restrict__ cs, const gf2 as, const gf2 bs) {
+    const __m128i *a = as->limb, *b = bs->limb;
+    __m128i *c = cs->limb;
+    __m128i accum0 = _mm_setzero_si128(), accum1 = _mm_setzero_si128(), accum2;
+    __m128i mask = _mm_set1_epi64x((1ull<<28)-1);
+    __m128i aa[8], bb[8];
+    int i, j;
+
+    for (i=0; i<8; i++) {
+        aa[i] = _mm_add_epi64(a[i], a[i+8]);
+        bb[i] = _mm_add_epi64(b[i], b[i+8]);
+    }
+
+    for (j=0; j<8; j++) {
+        accum2 = _mm_setzero_si128();
+        for (i=0; i<j+1; i++) {
+            accum2 = _mm_add_epi64(accum2, _mm_mul_epu32(a[j-i], b[i]));
+            accum1 = _mm_add_epi64(accum1, _mm_mul_epu32(aa[j-i], bb[i]));
+            accum0 = _mm_add_epi64(accum0, _mm_mul_epu32(a[8+j-i], b[8+i]));
+        }
+        accum1 = _mm_sub_epi64(accum1, accum2);
+        accum0 = _mm_add_epi64(accum0, accum2);
+
+        accum2 = _mm_setzero_si128();
+        for (i=j+1; i<8; i++) {
+            accum0 = _mm_sub_epi64(accum0, _mm_mul_epu32(a[8+j-i], b[i]));
+            accum2 = _mm_add_epi64(accum2, _mm_mul_epu32(aa[8+j-i], bb[i]));
+            accum1 = _mm_add_epi64(accum1, _mm_mul_epu32(a[16+j-i], b[8+i]));
+        }
+        accum1 = _mm_add_epi64(accum1, accum2);
+        accum0 = _mm_add_epi64(accum0, accum2);
+
+        c[j]   = _mm_and_si128(accum0, mask);
+        c[j+8] = _mm_and_si128(accum1, mask);
+        accum0 = _mm_srli_epi64(accum0, 28);
+        accum1 = _mm_srli_epi64(accum1, 28);
+    }
+
+    accum0 = _mm_add_epi64(_mm_add_epi64(accum0, accum1), c[8]);
+    accum1 = _mm_add_epi64(accum1, c[0]);
+    c[8] = _mm_and_si128(accum0, mask);
+    c[0] = _mm_and_si128(accum1, mask);
+    c[9] = _mm_add_epi64(c[9], _mm_srli_epi64(accum0, 28));
+    c[1] = _mm_add_epi64(c[1], _mm_srli_epi64(accum1, 28));
+}
+
+/** Lane-wise gf_mulw_unsigned */
+static void gf2_mulw_unsigned(gf2_s *__restrict__ cs, const gf2 as, uint32_t w) {
+    const __m128i *a = as->limb;
+    __m128i *c = cs->limb;
+    __m128i accum0 = _mm_setzero_si128(), accum8 = _mm_setzero_si128();
+    __m128i mask = _mm_set1_epi64x((1ull<<28)-1), vw = _mm_set1_epi64x(w);
+    int i;
+    assert(w<1<<28);
+
+    for (i=0; i<8; i++) {
+        accum0 = _mm_add_epi64(accum0, _mm_mul_epu32(vw, a[i]));
+        accum8 = _mm_add_epi64(accum8, _mm_mul_epu32(vw, a[i+8]));
+        c[i]   = _mm_and_si128(accum0, mask);
+        c[i+8] = _mm_and_si128(accum8, mask);
+        accum0 = _mm_srli_epi64(accum0, 28);
+        accum8 = _mm_srli_epi64(accum8, 28);
+    }
+
+    accum0 = _mm_add_epi64(_mm_add_epi64(accum0, accum8), c[8]);
+    c[8] = _mm_and_si128(accum0, mask);
+    c[9] = _mm_add_epi64(c[9], _mm_srli_epi64(accum0, 28));
+
+    accum8 = _mm_add_epi64(accum8, c[0]);
+    c[0] = _mm_and_si128(accum8, mask);
+    c[1] = _mm_add_epi64(c[1], _mm_srli_epi64(accum8, 28));
+}
+
+#endif /* __ARCH_32_F_VEC2_H__ */
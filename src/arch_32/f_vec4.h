@@ -0,0 +1,139 @@
+/* Copyright (c) 2018 the libgoldilocks contributors.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+/*
+ * Quadruples of field elements for the Edwards formulas, one in each 64-bit
+ * lane of an AVX2 vector.  As in f_vec2.h, each lane holds a limb as in
+ * f_impl.c and gf4_mul follows gf_mul exactly, so the bounds of
+ * GF_MUL_BOUND apply lane by lane.  Lanes are moved around with
+ * gf4_perm and gf4_blend, whose immediates are built with GF4_LANES.
+ */
+
+#ifndef __ARCH_32_F_VEC4_H__
+#define __ARCH_32_F_VEC4_H__ 1
+
+#include <immintrin.h>
+
+typedef struct gf4_s {
+    __m256i limb[16];
+} gf4_s, gf4[1];
+
+/** Lane selector for gf4_perm: output lane i takes input lane li */
+#define GF4_LANES(l0,l1,l2,l3) ((l0) | (l1)<<2 | (l2)<<4 | (l3)<<6)
+
+/** Lane mask for gf4_blend: output lane i takes b if bi, else a */
+#define GF4_BLEND(b0,b1,b2,b3) \
+    ((b0)*0x03 | (b1)*0x0c | (b2)*0x30 | (b3)*0xc0)
+
+/** out = (l0, l1, l2, l3) */
+static GOLDILOCKS_INLINE void gf4_pack(
+    gf4 out, const gf l0, const gf l1, const gf l2, const gf l3
+) {
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        out->limb[i] = _mm256_set_epi64x(l3->limb[i], l2->limb[i], l1->limb[i], l0->limb[i]);
+    }
+}
+
+/** (l0, l1, l2, l3) = in */
+static GOLDILOCKS_INLINE void gf4_unpack(gf l0, gf l1, gf l2, gf l3, const gf4 in) {
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        __m128i lo = _mm256_castsi256_si128(in->limb[i]);
+        __m128i hi = _mm256_extracti128_si256(in->limb[i], 1);
+        l0->limb[i] = _mm_cvtsi128_si32(lo);
+        l1->limb[i] = _mm_cvtsi128_si32(_mm_srli_si128(lo, 8));
+        l2->limb[i] = _mm_cvtsi128_si32(hi);
+        l3->limb[i] = _mm_cvtsi128_si32(_mm_srli_si128(hi, 8));
+    }
+}
+
+/** out = lanes of a, chosen by imm = GF4_LANES(...) */
+#define gf4_perm(out, a, imm) do { \
+    unsigned int i_; \
+    for (i_=0; i_<16; i_++) (out)->limb[i_] = _mm256_permute4x64_epi64((a)->limb[i_], imm); \
+} while (0)
+
+/** out = lanes of a or b, chosen by imm = GF4_BLEND(...) */
+#define gf4_blend(out, a, b, imm) do { \
+    unsigned int i_; \
+    for (i_=0; i_<16; i_++) (out)->limb[i_] = _mm256_blend_epi32((a)->limb[i_], (b)->limb[i_], imm); \
+} while (0)
+
+static GOLDILOCKS_INLINE void gf4_add_RAW(gf4 out, const gf4 a, const gf4 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm256_add_epi64(a->limb[i], b->limb[i]);
+}
+
+static GOLDILOCKS_INLINE void gf4_sub_RAW(gf4 out, const gf4 a, const gf4 b) {
+    unsigned int i;
+    for (i=0; i<16; i++) out->limb[i] = _mm256_sub_epi64(a->limb[i], b->limb[i]);
+}
+
+static GOLDILOCKS_INLINE void gf4_bias(gf4 a, int amt) {
+    uint32_t co1 = ((1ull<<28)-1)*amt, co2 = co1-amt;
+    __m256i lo = _mm256_set1_epi64x(co1), hi = _mm256_set1_epi64x(co2);
+    unsigned int i;
+    for (i=0; i<16; i++) a->limb[i] = _mm256_add_epi64(a->limb[i], (i==8) ? hi : lo);
+}
+
+static GOLDILOCKS_INLINE void gf4_weak_reduce(gf4 a) {
+    __m256i mask = _mm256_set1_epi64x((1ull<<28)-1);
+    __m256i tmp = _mm256_srli_epi64(a->limb[15], 28);
+    unsigned int i;
+    a->limb[8] = _mm256_add_epi64(a->limb[8], tmp);
+    for (i=15; i>0; i--) {
+        a->limb[i] = _mm256_add_epi64(_mm256_and_si256(a->limb[i], mask), _mm256_srli_epi64(a->limb[i-1], 28));
+    }
+    a->limb[0] = _mm256_add_epi64(_mm256_and_si256(a->limb[0], mask), tmp);
+}
+
+/** Lane-wise gf_mul */
+static void gf4_mul(gf4_s *__restrict__ cs, const gf4 as, const gf4 bs) {
+    const __m256i *a = as->limb, *b = bs->limb;
+    __m256i *c = cs->limb;
+    __m256i accum0 = _mm256_setzero_si256(), accum1 = _mm256_setzero_si256(), accum2;
+    __m256i mask = _mm256_set1_epi64x((1ull<<28)-1);
+    __m256i aa[8], bb[8];
+    int i, j;
+
+    for (i=0; i<8; i++) {
+        aa[i] = _mm256_add_epi64(a[i], a[i+8]);
+        bb[i] = _mm256_add_epi64(b[i], b[i+8]);
+    }
+
+    for (j=0; j<8; j++) {
+        accum2 = _mm256_setzero_si256();
+        for (i=0; i<j+1; i++) {
+            accum2 = _mm256_add_epi64(accum2, _mm256_mul_epu32(a[j-i], b[i]));
+            accum1 = _mm256_add_epi64(accum1, _mm256_mul_epu32(aa[j-i], bb[i]));
+            accum0 = _mm256_add_epi64(accum0, _mm256_mul_epu32(a[8+j-i], b[8+i]));
+        }
+        accum1 = _mm256_sub_epi64(accum1, accum2);
+        accum0 = _mm256_add_epi64(accum0, accum2);
+
+        accum2 = _mm256_setzero_si256();
+        for (i=j+1; i<8; i++) {
+            accum0 = _mm256_sub_epi64(accum0, _mm256_mul_epu32(a[8+j-i], b[i]));
+            accum2 = _mm256_add_epi64(accum2, _mm256_mul_epu32(aa[8+j-i], bb[i]));
+            accum1 = _mm256_add_epi64(accum1, _mm256_mul_epu32(a[16+j-i], b[8+i]));
+        }
+        accum1 = _mm256_add_epi64(accum1, accum2);
+        accum0 = _mm256_add_epi64(accum0, accum2);
+
+        c[j]   = _mm256_and_si256(accum0, mask);
+        c[j+8] = _mm256_and_si256(accum1, mask);
+        accum0 = _mm256_srli_epi64(accum0, 28);
+        accum1 = _mm256_srli_epi64(accum1, 28);
+    }
+
+    accum0 = _mm256_add_epi64(_mm256_add_epi64(accum0, accum1), c[8]);
+    accum1 = _mm256_add_epi64(accum1, c[0]);
+    c[8] = _mm256_and_si256(accum0, mask);
+    c[0] = _mm256_and_si256(accum1, mask);
+    c[9] = _mm256_add_epi64(c[9], _mm256_srli_epi64(accum0, 28));
+    c[1] = _mm256_add_epi64(c[1], _mm256_srli_epi64(accum1, 28));
+}
+
+#endif /* __ARCH_32_F_VEC4_H__ */
@@ -5,7 +5,29 @@
 
 #include "f_field.h"
 
-void gf_mul (gf_s *__restrict__ cs, const gf as, const gf bs) {
+/* Multiplication with mulx and two ADX carry chains is used when the build
+ * targets BMI2 and ADX, or otherwise when the CPU reports them at load
+ * time.  Define GOLDILOCKS_NO_ADX to use only the mulq code.
+ */
+#if defined(GOLDILOCKS_NO_ADX)
+#define GF_ADX 0
+#elif defined(__BMI2__) && defined(__ADX__)
+#define GF_ADX 1
+#else
+#define GF_ADX 2
+#include <cpuid.h>
+
+static int gf_have_adx = 0;
+
+static void __attribute__((constructor)) gf_detect_adx(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        gf_have_adx = (ebx & bit_BMI2) && (ebx & bit_ADX);
+    }
+}
+#endif
+
+static __attribute__((unused)) void gf_mul_base (gf_s *__restrict__ cs, const gf as, const gf bs) {
     const uint64_t *a = as->limb, *b = bs->limb;
     uint64_t *c = cs->limb;
 
@@ -180,7 +202,7 @@ void gf_mulw_unsigned (gf_s *__restrict__ cs, const gf as, uint32_t b) {
     c[1] += accum4 >> 56;
 }
 
-void gf_sqr (gf_s *__restrict__ cs, const gf as) {
+static __attribute__((unused)) void gf_sqr_base (gf_s *__restrict__ cs, const gf as) {
     const uint64_t *a = as->limb;
     uint64_t *c = cs->limb;
 
@@ -290,3 +312,244 @@ void gf_sqr (gf_s *__restrict__ cs, const gf as) {
     c[4] += ((uint64_t)(accum0)) + ((uint64_t)(accum1));
     c[0] += ((uint64_t)(accum1));
 }
+
+#if GF_ADX
+#define WIDE(x,y) ((__uint128_t)(x)*(y))
+
+/* The schedule of gf_mul_base, with the accum0 and accum1 products paired
+ * up on separate carry chains.
+ */
+static __attribute__((target("bmi2,adx")))
+void gf_mul_adx (gf_s *__restrict__ cs, const gf as, const gf bs) {
+    const uint64_t *a = as->limb, *b = bs->limb;
+    uint64_t *c = cs->limb;
+
+    __uint128_t accum0, accum1, accum2;
+    uint64_t mask = (1ull<<56) - 1;
+    uint64_t aa[4], bb[4], bbb[4];
+
+    unsigned int i;
+    for (i=0; i<4; i++) {
+        aa[i] = a[i] + a[i+4];
+        bb[i] = b[i] + b[i+4];
+        bbb[i] = bb[i] + b[i+4];
+    }
+
+    accum2 = WIDE(a[0],b[3]);
+    accum0 = WIDE(aa[0],bb[3]);
+    accum1 = WIDE(a[4],b[7]);
+    accum2 += WIDE(a[1],b[2]);
+    mac_adx2(&accum0, aa[1], bb[2], &accum1, a[5], b[6]);
+    accum2 += WIDE(a[2],b[1]);
+    mac_adx2(&accum0, aa[2], bb[1], &accum1, a[6], b[5]);
+    accum2 += WIDE(a[3],b[0]);
+    mac_adx2(&accum0, aa[3], bb[0], &accum1, a[7], b[4]);
+
+    accum0 -= accum2;
+    accum1 += accum2;
+
+    c[3] = ((uint64_t)(accum1)) & mask;
+    c[7] = ((uint64_t)(accum0)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    mac_adx2(&accum0, aa[1], bb[3], &accum1, a[5], b[7]);
+    mac_adx2(&accum0, aa[2], bb[2], &accum1, a[6], b[6]);
+    accum0 += WIDE(aa[3],bb[1]);
+    accum1 += accum0;
+
+    accum2 = WIDE(a[0],b[0]);
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    accum0 -= WIDE(a[1],b[3]);
+    accum0 -= WIDE(a[2],b[2]);
+    accum0 -= WIDE(a[3],b[1]);
+    mac_adx2(&accum0, a[4], b[4], &accum1, a[7], b[5]);
+    accum1 += WIDE(aa[0],bb[0]);
+
+    c[0] = ((uint64_t)(accum0)) & mask;
+    c[4] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum2 = WIDE(a[2],b[7]);
+    mac_adx2(&accum0, a[6], bb[3], &accum1, aa[2], bbb[3]);
+    accum2 += WIDE(a[3],b[6]);
+    mac_adx2(&accum0, a[7], bb[2], &accum1, aa[3], bbb[2]);
+    accum2 += WIDE(a[0],b[1]);
+    mac_adx2(&accum0, a[4], b[5], &accum1, aa[0], bb[1]);
+    accum2 += WIDE(a[1],b[0]);
+    mac_adx2(&accum0, a[5], b[4], &accum1, aa[1], bb[0]);
+
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    c[1] = ((uint64_t)(accum0)) & mask;
+    c[5] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum2 = WIDE(a[3],b[7]);
+    mac_adx2(&accum0, a[7], bb[3], &accum1, aa[3], bbb[3]);
+    accum2 += WIDE(a[0],b[2]);
+    mac_adx2(&accum0, a[4], b[6], &accum1, aa[0], bb[2]);
+    accum2 += WIDE(a[1],b[1]);
+    mac_adx2(&accum0, a[5], b[5], &accum1, aa[1], bb[1]);
+    accum2 += WIDE(a[2],b[0]);
+    mac_adx2(&accum0, a[6], b[4], &accum1, aa[2], bb[0]);
+
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    c[2] = ((uint64_t)(accum0)) & mask;
+    c[6] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum0 += c[3];
+    accum1 += c[7];
+    c[3] = ((uint64_t)(accum0)) & mask;
+    c[7] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+    c[4] += ((uint64_t)(accum0)) + ((uint64_t)(accum1));
+    c[0] += ((uint64_t)(accum1));
+}
+
+/* The schedule of gf_sqr_base, paired up in the same way */
+static __attribute__((target("bmi2,adx")))
+void gf_sqr_adx (gf_s *__restrict__ cs, const gf as) {
+    const uint64_t *a = as->limb;
+    uint64_t *c = cs->limb;
+
+    __uint128_t accum0, accum1, accum2;
+    uint64_t mask = (1ull<<56) - 1;
+    uint64_t aa[4];
+
+    unsigned int i;
+    for (i=0; i<4; i++) {
+        aa[i] = a[i] + a[i+4];
+    }
+
+    accum2 = WIDE(a[0],a[3]);
+    accum0 = WIDE(aa[0],aa[3]);
+    accum1 = WIDE(a[4],a[7]);
+    accum2 += WIDE(a[1],a[2]);
+    mac_adx2(&accum0, aa[1], aa[2], &accum1, a[5], a[6]);
+
+    accum0 -= accum2;
+    accum1 += accum2;
+
+    c[3] = ((uint64_t)(accum1))<<1 & mask;
+    c[7] = ((uint64_t)(accum0))<<1 & mask;
+
+    accum0 >>= 55;
+    accum1 >>= 55;
+
+    mac_adx2(&accum0, 2*aa[1], aa[3], &accum1, 2*a[5], a[7]);
+    accum0 += WIDE(aa[2],aa[2]);
+    accum1 += accum0;
+
+    accum0 -= WIDE(2*a[1],a[3]);
+    accum1 += WIDE(a[6],a[6]);
+
+    accum2 = WIDE(a[0],a[0]);
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    accum0 -= WIDE(a[2],a[2]);
+    mac_adx2(&accum0, a[4], a[4], &accum1, aa[0], aa[0]);
+
+    c[0] = ((uint64_t)(accum0)) & mask;
+    c[4] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum2 = WIDE(2*aa[2],aa[3]);
+    accum0 -= WIDE(2*a[2],a[3]);
+    accum1 += WIDE(2*a[6],a[7]);
+
+    accum1 += accum2;
+    accum0 += accum2;
+
+    accum2 = WIDE(2*a[0],a[1]);
+    mac_adx2(&accum0, 2*a[4], a[5], &accum1, 2*aa[0], aa[1]);
+
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    c[1] = ((uint64_t)(accum0)) & mask;
+    c[5] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum2 = WIDE(aa[3],aa[3]);
+    accum0 -= WIDE(a[3],a[3]);
+    accum1 += WIDE(a[7],a[7]);
+
+    accum1 += accum2;
+    accum0 += accum2;
+
+    accum2 = WIDE(2*a[0],a[2]);
+    mac_adx2(&accum0, 2*a[4], a[6], &accum1, 2*aa[0], aa[2]);
+    accum2 += WIDE(a[1],a[1]);
+    mac_adx2(&accum0, a[5], a[5], &accum1, aa[1], aa[1]);
+
+    accum1 -= accum2;
+    accum0 += accum2;
+
+    c[2] = ((uint64_t)(accum0)) & mask;
+    c[6] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+
+    accum0 += c[3];
+    accum1 += c[7];
+    c[3] = ((uint64_t)(accum0)) & mask;
+    c[7] = ((uint64_t)(accum1)) & mask;
+
+    accum0 >>= 56;
+    accum1 >>= 56;
+    c[4] += ((uint64_t)(accum0)) + ((uint64_t)(accum1));
+    c[0] += ((uint64_t)(accum1));
+}
+
+#undef WIDE
+#endif /* GF_ADX */
+
+void gf_mul (gf_s *__restrict__ cs, const gf as, const gf bs) {
+#if GF_ADX == 1
+    gf_mul_adx(cs,as,bs);
+#else
+#if GF_ADX == 2
+    if (gf_have_adx) {
+        gf_mul_adx(cs,as,bs);
+        return;
+    }
+#endif
+    gf_mul_base(cs,as,bs);
+#endif
+}
+
+void gf_sqr (gf_s *__restrict__ cs, const gf as) {
+#if GF_ADX == 1
+    gf_sqr_adx(cs,as);
+#else
+#if GF_ADX == 2
+    if (gf_have_adx) {
+        gf_sqr_adx(cs,as);
+        return;
+    }
+#endif
+    gf_sqr_base(cs,as);
+#endif
+}
@@ -14,6 +14,7 @@
 #include <goldilocks/ed448.h>
 #include <goldilocks/shake.h>
 #include <string.h>
+#include <pthread.h>
 #include "api.h"
 
 #define hash_ctx_p   goldilocks_shake256_ctx_p
@@ -250,7 +251,9 @@ void goldilocks_ed448_sign_prehash (
     goldilocks_bzero(hash_output,sizeof(hash_output));
 }
 
-goldilocks_error_t goldilocks_ed448_verify (
+/* Verify against an already-decoded public key.  Clobbers pk_point. */
+static goldilocks_error_t verify_with_point (
+    API_NS(point_p) pk_point,
     const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
     const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
     const uint8_t *message,
@@ -259,12 +262,11 @@ goldilocks_error_t goldilocks_ed448_verify (
     const uint8_t *context,
     uint8_t context_len
 ) {
-    API_NS(point_p) pk_point, r_point;
+    API_NS(point_p) r_point;
     API_NS(scalar_p) challenge_scalar;
     API_NS(scalar_p) response_scalar;
     unsigned  int c;
-    goldilocks_error_t error = API_NS(point_decode_like_eddsa_and_mul_by_ratio)(pk_point,pubkey);
-    if (GOLDILOCKS_SUCCESS != error) { return error; }
+    goldilocks_error_t error;
 
     error = API_NS(point_decode_like_eddsa_and_mul_by_ratio)(r_point,signature);
     if (GOLDILOCKS_SUCCESS != error) { return error; }
@@ -305,6 +307,22 @@ goldilocks_error_t goldilocks_ed448_verify (
     return goldilocks_succeed_if(API_NS(point_eq(pk_point,r_point)));
 }
 
+goldilocks_error_t goldilocks_ed448_verify (
+    const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    const uint8_t *message,
+    size_t message_len,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len
+) {
+    API_NS(point_p) pk_point;
+    goldilocks_error_t error = API_NS(point_decode_like_eddsa_and_mul_by_ratio)(pk_point,pubkey);
+    if (GOLDILOCKS_SUCCESS != error) { return error; }
+
+    return verify_with_point(pk_point,signature,pubkey,message,message_len,prehashed,context,context_len);
+}
+
 
 goldilocks_error_t goldilocks_ed448_verify_prehash (
     const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
@@ -327,3 +345,383 @@ goldilocks_error_t goldilocks_ed448_verify_prehash (
 
     return ret;
 }
+
+/* Verifier cache.  Keys are spread over independently locked shards, each of
+ * which is a chained hash table threaded onto an LRU list.
+ */
+#define VERIFIER_CACHE_SHARDS 16
+
+struct verifier_cache_entry {
+    API_NS(point_p) point;
+    uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES];
+    uint32_t hash;
+    struct verifier_cache_entry *chain, *newer, *older;
+};
+
+struct verifier_cache_shard {
+    pthread_mutex_t lock;
+    struct verifier_cache_entry *entries, **buckets;
+    struct verifier_cache_entry *newest, *oldest;
+    size_t used, capacity, bucket_mask;
+    uint64_t hits, misses;
+};
+
+struct goldilocks_ed448_verifier_cache_s {
+    struct verifier_cache_shard shard[VERIFIER_CACHE_SHARDS];
+};
+
+/* FNV-1a.  Public keys are not secret, and a colliding chain costs at most one
+ * shard's worth of comparisons.
+ */
+static uint32_t verifier_cache_hash (
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES]
+) {
+    uint32_t h = 2166136261u;
+    unsigned int i;
+    for (i=0; i<GOLDILOCKS_EDDSA_448_PUBLIC_BYTES; i++) {
+        h = (h ^ pubkey[i]) * 16777619u;
+    }
+    return h;
+}
+
+static void verifier_cache_unlink_lru (
+    struct verifier_cache_shard *shard,
+    struct verifier_cache_entry *e
+) {
+    if (e->newer) e->newer->older = e->older; else shard->newest = e->older;
+    if (e->older) e->older->newer = e->newer; else shard->oldest = e->newer;
+    e->newer = e->older = NULL;
+}
+
+static void verifier_cache_push_lru (
+    struct verifier_cache_shard *shard,
+    struct verifier_cache_entry *e
+) {
+    e->newer = NULL;
+    e->older = shard->newest;
+    if (shard->newest) shard->newest->newer = e; else shard->oldest = e;
+    shard->newest = e;
+}
+
+static struct verifier_cache_entry *verifier_cache_find (
+    struct verifier_cache_shard *shard,
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    uint32_t hash
+) {
+    struct verifier_cache_entry *e = shard->buckets[(hash / VERIFIER_CACHE_SHARDS) & shard->bucket_mask];
+    for (; e; e = e->chain) {
+        if (e->hash == hash && !memcmp(e->pubkey, pubkey, sizeof(e->pubkey))) return e;
+    }
+    return NULL;
+}
+
+static void verifier_cache_insert (
+    struct verifier_cache_shard *shard,
+    const API_NS(point_p) point,
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    uint32_t hash
+) {
+    struct verifier_cache_entry *e, **link;
+
+    if (shard->used < shard->capacity) {
+        e = &shard->entries[shard->used++];
+    } else {
+        /* Evict the least recently used key */
+        e = shard->oldest;
+        verifier_cache_unlink_lru(shard, e);
+        link = &shard->buckets[(e->hash / VERIFIER_CACHE_SHARDS) & shard->bucket_mask];
+        while (*link != e) link = &(*link)->chain;
+        *link = e->chain;
+    }
+
+    API_NS(point_copy)(e->point, point);
+    memcpy(e->pubkey, pubkey, sizeof(e->pubkey));
+    e->hash = hash;
+    link = &shard->buckets[(hash / VERIFIER_CACHE_SHARDS) & shard->bucket_mask];
+    e->chain = *link;
+    *link = e;
+    verifier_cache_push_lru(shard, e);
+}
+
+/* Decode pubkey into point, through the cache if there is one. */
+static goldilocks_error_t verifier_cache_decode (
+    goldilocks_ed448_verifier_cache_s *cache,
+    API_NS(point_p) point,
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES]
+) {
+    struct verifier_cache_shard *shard;
+    struct verifier_cache_entry *e;
+    uint32_t hash;
+    goldilocks_error_t error;
+
+    if (cache == NULL) {
+        return API_NS(point_decode_like_eddsa_and_mul_by_ratio)(point,pubkey);
+    }
+
+    hash = verifier_cache_hash(pubkey);
+    shard = &cache->shard[hash % VERIFIER_CACHE_SHARDS];
+
+    pthread_mutex_lock(&shard->lock);
+    e = verifier_cache_find(shard, pubkey, hash);
+    if (e) {
+        API_NS(point_copy)(point, e->point);
+        verifier_cache_unlink_lru(shard, e);
+        verifier_cache_push_lru(shard, e);
+        shard->hits++;
+    } else {
+        shard->misses++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    if (e) return GOLDILOCKS_SUCCESS;
+
+    /* Decode without holding the lock */
+    error = API_NS(point_decode_like_eddsa_and_mul_by_ratio)(point,pubkey);
+    if (GOLDILOCKS_SUCCESS != error) return error;
+
+    pthread_mutex_lock(&shard->lock);
+    if (shard->capacity && !verifier_cache_find(shard, pubkey, hash)) {
+        verifier_cache_insert(shard, point, pubkey, hash);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return GOLDILOCKS_SUCCESS;
+}
+
+goldilocks_ed448_verifier_cache_s *goldilocks_ed448_verifier_cache_create (
+    size_t capacity
+) {
+    goldilocks_ed448_verifier_cache_s *cache;
+    unsigned int i;
+
+    cache = (goldilocks_ed448_verifier_cache_s *)calloc(1, sizeof(*cache));
+    if (cache == NULL) return NULL;
+
+    for (i=0; i<VERIFIER_CACHE_SHARDS; i++) {
+        struct verifier_cache_shard *shard = &cache->shard[i];
+        size_t nbuckets = 1;
+        void *entries = NULL;
+
+        /* Spread the capacity evenly; the first shards take the remainder */
+        shard->capacity = capacity / VERIFIER_CACHE_SHARDS + (i < capacity % VERIFIER_CACHE_SHARDS);
+        while (nbuckets < shard->capacity) nbuckets <<= 1;
+        shard->bucket_mask = nbuckets - 1;
+
+        if (pthread_mutex_init(&shard->lock, NULL)) goto fail;
+        shard->buckets = (struct verifier_cache_entry **)calloc(nbuckets, sizeof(*shard->buckets));
+        if (shard->buckets == NULL
+            || (shard->capacity && posix_memalign(&entries, sizeof(big_register_t),
+                    shard->capacity * sizeof(struct verifier_cache_entry)))
+        ) {
+            pthread_mutex_destroy(&shard->lock);
+            free(shard->buckets);
+            goto fail;
+        }
+        shard->entries = (struct verifier_cache_entry *)entries;
+        continue;
+
+    fail:
+        while (i--) {
+            pthread_mutex_destroy(&cache->shard[i].lock);
+            free(cache->shard[i].entries);
+            free(cache->shard[i].buckets);
+        }
+        free(cache);
+        return NULL;
+    }
+
+    return cache;
+}
+
+void goldilocks_ed448_verifier_cache_destroy (
+    goldilocks_ed448_verifier_cache_s *cache
+) {
+    unsigned int i;
+    if (cache == NULL) return;
+    for (i=0; i<VERIFIER_CACHE_SHARDS; i++) {
+        struct verifier_cache_shard *shard = &cache->shard[i];
+        pthread_mutex_destroy(&shard->lock);
+        if (shard->entries) {
+            goldilocks_bzero(shard->entries, shard->capacity * sizeof(*shard->entries));
+        }
+        free(shard->entries);
+        free(shard->buckets);
+    }
+    free(cache);
+}
+
+void goldilocks_ed448_verifier_cache_stats (
+    goldilocks_ed448_verifier_cache_s *cache,
+    uint64_t *hits,
+    uint64_t *misses
+) {
+    unsigned int i;
+    *hits = *misses = 0;
+    for (i=0; i<VERIFIER_CACHE_SHARDS; i++) {
+        struct verifier_cache_shard *shard = &cache->shard[i];
+        pthread_mutex_lock(&shard->lock);
+        *hits += shard->hits;
+        *misses += shard->misses;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+goldilocks_error_t goldilocks_ed448_verify_cached (
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    const uint8_t *message,
+    size_t message_len,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len
+) {
+    API_NS(point_p) pk_point;
+    goldilocks_error_t error = verifier_cache_decode(cache,pk_point,pubkey);
+    if (GOLDILOCKS_SUCCESS != error) { return error; }
+
+    return verify_with_point(pk_point,signature,pubkey,message,message_len,prehashed,context,context_len);
+}
+
+goldilocks_error_t goldilocks_ed448_verify_prehash_cached (
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    const goldilocks_ed448_prehash_ctx_p hash,
+    const uint8_t *context,
+    uint8_t context_len
+) {
+    uint8_t hash_output[EDDSA_PREHASH_BYTES];
+    {
+        goldilocks_ed448_prehash_ctx_p hash_too;
+        memcpy(hash_too,hash,sizeof(hash_too));
+        hash_final(hash_too,hash_output,sizeof(hash_output));
+        hash_destroy(hash_too);
+    }
+
+    return goldilocks_ed448_verify_cached(cache,signature,pubkey,hash_output,sizeof(hash_output),1,context,context_len);
+}
+
+/* Batch operations.  Each task runs the single-shot function on its items. */
+struct ed448_batch {
+    uint8_t *out;
+    goldilocks_bool_t *successes;
+    goldilocks_ed448_verifier_cache_s *cache;
+    const uint8_t *privkeys, *pubkeys, *signatures;
+    const uint8_t *const *messages;
+    const size_t *message_lens;
+    uint8_t prehashed;
+    const uint8_t *context;
+    uint8_t context_len;
+};
+
+static void ed448_derive_public_key_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct ed448_batch *b = (const struct ed448_batch *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i=first; i<first+count; i++) {
+        goldilocks_ed448_derive_public_key(
+            &b->out[i*GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+            &b->privkeys[i*GOLDILOCKS_EDDSA_448_PRIVATE_BYTES]
+        );
+    }
+}
+
+static void ed448_sign_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct ed448_batch *b = (const struct ed448_batch *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i=first; i<first+count; i++) {
+        goldilocks_ed448_sign(
+            &b->out[i*GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+            &b->privkeys[i*GOLDILOCKS_EDDSA_448_PRIVATE_BYTES],
+            &b->pubkeys[i*GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+            b->messages[i], b->message_lens[i],
+            b->prehashed, b->context, b->context_len
+        );
+    }
+}
+
+static void ed448_verify_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct ed448_batch *b = (const struct ed448_batch *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i=first; i<first+count; i++) {
+        b->successes[i] = goldilocks_successful(goldilocks_ed448_verify_cached(
+            b->cache,
+            &b->signatures[i*GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+            &b->pubkeys[i*GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+            b->messages[i], b->message_lens[i],
+            b->prehashed, b->context, b->context_len
+        ));
+    }
+}
+
+void goldilocks_ed448_derive_public_key_batch (
+    uint8_t *pubkeys,
+    const uint8_t *privkeys,
+    size_t n,
+    goldilocks_pool_s *pool
+) {
+    struct ed448_batch b;
+    memset(&b, 0, sizeof(b));
+    b.out = pubkeys;
+    b.privkeys = privkeys;
+    (void)goldilocks_pool_run(pool, n, 0, 0, ed448_derive_public_key_task, &b);
+}
+
+void goldilocks_ed448_sign_batch (
+    uint8_t *signatures,
+    const uint8_t *privkeys,
+    const uint8_t *pubkeys,
+    const uint8_t *const messages[],
+    const size_t message_lens[],
+    size_t n,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len,
+    goldilocks_pool_s *pool
+) {
+    struct ed448_batch b;
+    memset(&b, 0, sizeof(b));
+    b.out = signatures;
+    b.privkeys = privkeys;
+    b.pubkeys = pubkeys;
+    b.messages = messages;
+    b.message_lens = message_lens;
+    b.prehashed = prehashed;
+    b.context = context;
+    b.context_len = context_len;
+    (void)goldilocks_pool_run(pool, n, 0, 0, ed448_sign_task, &b);
+}
+
+goldilocks_error_t goldilocks_ed448_verify_batch (
+    goldilocks_bool_t successes[],
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t *signatures,
+    const uint8_t *pubkeys,
+    const uint8_t *const messages[],
+    const size_t message_lens[],
+    size_t n,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len,
+    goldilocks_pool_s *pool
+) {
+    struct ed448_batch b;
+    goldilocks_bool_t all = GOLDILOCKS_TRUE;
+    size_t i;
+
+    memset(&b, 0, sizeof(b));
+    b.successes = successes;
+    b.cache = cache;
+    b.signatures = signatures;
+    b.pubkeys = pubkeys;
+    b.messages = messages;
+    b.message_lens = message_lens;
+    b.prehashed = prehashed;
+    b.context = context;
+    b.context_len = context_len;
+    (void)goldilocks_pool_run(pool, n, 0, 0, ed448_verify_task, &b);
+
+    for (i=0; i<n; i++) all &= successes[i];
+    return goldilocks_succeed_if(all);
+}
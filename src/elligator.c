@@ -12,7 +12,7 @@
 #include "word.h"
 #include "field.h"
 #include <goldilocks.h>
-#include <stdio.h>
+#include <goldilocks/spongerng.h>
 #include "api.h"
 
 /* Template stuff */
@@ -94,6 +94,49 @@ void API_NS(point_from_hash_uniform) (
     API_NS(point_add)(pt,pt,pt2);
 }
 
+/* Elements squeezed from the RNG at a time by the random_batch functions.
+ * The scalar one lives here rather than in scalar.c, because scalar.c is also
+ * linked into goldilocks_gen_tables, which doesn't have the RNG.
+ */
+#define RANDOM_BATCH 32
+#define RANDOM_SCALAR_BYTES (SCALAR_SER_BYTES+16)
+
+void API_NS(scalar_random_batch) (
+    goldilocks_keccak_prng_p rng,
+    scalar_p out[],
+    size_t n
+) {
+    unsigned char bytes[RANDOM_BATCH*RANDOM_SCALAR_BYTES];
+    size_t i, todo;
+
+    for (; n; n -= todo, out += todo) {
+        todo = (n > RANDOM_BATCH) ? RANDOM_BATCH : n;
+        goldilocks_spongerng_next(rng, bytes, todo*RANDOM_SCALAR_BYTES);
+        for (i=0; i<todo; i++) {
+            API_NS(scalar_decode_long)(out[i], &bytes[i*RANDOM_SCALAR_BYTES], RANDOM_SCALAR_BYTES);
+        }
+    }
+    goldilocks_bzero(bytes, sizeof(bytes));
+}
+
+void API_NS(point_random_batch) (
+    goldilocks_keccak_prng_p rng,
+    point_p out[],
+    size_t n
+) {
+    unsigned char bytes[RANDOM_BATCH*2*SER_BYTES];
+    size_t i, todo;
+
+    for (; n; n -= todo, out += todo) {
+        todo = (n > RANDOM_BATCH) ? RANDOM_BATCH : n;
+        goldilocks_spongerng_next(rng, bytes, todo*2*SER_BYTES);
+        for (i=0; i<todo; i++) {
+            API_NS(point_from_hash_uniform)(out[i], &bytes[i*2*SER_BYTES]);
+        }
+    }
+    goldilocks_bzero(bytes, sizeof(bytes));
+}
+
 /* Elligator_onto:
  * Make elligator-inverse onto at the cost of roughly halving the success probability.
  * Currently no effect for curves with field size 1 bit mod 8 (where the top bit
@@ -117,11 +160,6 @@ API_NS(invert_elligator_nonuniform) (
          */
         sgn_ed_T = -(hint>>3 & 1);
 
-    printf("1 %x \n", sgn_s);
-    printf("2 %x \n", sgn_altx);
-    printf("3 %x \n", sgn_r0);
-    printf("4 %x \n", sgn_ed_T);
-
     gf a,b,c;
     mask_t is_identity;
     mask_t succ;
@@ -163,3 +201,77 @@ API_NS(invert_elligator_uniform) (
     API_NS(point_sub)(pt2,p,pt2);
     return API_NS(invert_elligator_nonuniform)(partial_hash,pt2,hint);
 }
+
+void API_NS(invert_elligator_uniform_batch) (
+    unsigned char *partial_hashes,
+    goldilocks_bool_t successes[],
+    const point_p pts[],
+    const uint32_t hints[],
+    size_t n
+) {
+    size_t i;
+    for (i=0; i<n; i++) {
+        successes[i] = goldilocks_successful(
+            API_NS(invert_elligator_uniform)(&partial_hashes[2*i*SER_BYTES],pts[i],hints[i])
+        );
+    }
+}
+
+/* Points encoded per round by point_steg_encode_batch */
+#define STEG_BATCH 32
+#define STEG_RANDOM_BYTES (SER_BYTES+4)
+
+void API_NS(point_steg_encode_batch) (
+    unsigned char *out,
+    const point_p pts[],
+    size_t n,
+    goldilocks_keccak_prng_p rng,
+    uint64_t histogram[GOLDILOCKS_448_STEG_HISTOGRAM_BINS]
+) {
+    point_p pending[STEG_BATCH];
+    size_t where[STEG_BATCH];
+    unsigned char hashes[STEG_BATCH*2*SER_BYTES], random[STEG_BATCH*STEG_RANDOM_BYTES];
+    uint32_t hints[STEG_BATCH];
+    goldilocks_bool_t successes[STEG_BATCH];
+    size_t i, j, todo, npending;
+    unsigned int attempt;
+
+    for (; n; n -= todo, pts += todo, out += todo*2*SER_BYTES) {
+        todo = (n > STEG_BATCH) ? STEG_BATCH : n;
+        for (i=0; i<todo; i++) {
+            API_NS(point_copy)(pending[i],pts[i]);
+            where[i] = i;
+        }
+
+        for (npending = todo, attempt = 0; npending; attempt++) {
+            /* One squeeze per round: a fresh upper half and hint for each point left */
+            goldilocks_spongerng_next(rng, random, npending*STEG_RANDOM_BYTES);
+            for (i=0; i<npending; i++) {
+                const unsigned char *r = &random[i*STEG_RANDOM_BYTES];
+                memcpy(&hashes[(2*i+1)*SER_BYTES], r, SER_BYTES);
+                hints[i] = (uint32_t)r[SER_BYTES] | (uint32_t)r[SER_BYTES+1]<<8
+                    | (uint32_t)r[SER_BYTES+2]<<16 | (uint32_t)r[SER_BYTES+3]<<24;
+            }
+
+            API_NS(invert_elligator_uniform_batch)(hashes,successes,(const point_p *)pending,hints,npending);
+
+            for (i=j=0; i<npending; i++) {
+                if (successes[i]) {
+                    memcpy(&out[where[i]*2*SER_BYTES], &hashes[2*i*SER_BYTES], 2*SER_BYTES);
+                    if (histogram) {
+                        histogram[(attempt < GOLDILOCKS_448_STEG_HISTOGRAM_BINS)
+                                  ? attempt : GOLDILOCKS_448_STEG_HISTOGRAM_BINS-1]++;
+                    }
+                } else {
+                    API_NS(point_copy)(pending[j],pending[i]);
+                    where[j++] = where[i];
+                }
+            }
+            npending = j;
+        }
+    }
+
+    goldilocks_bzero(hashes, sizeof(hashes));
+    goldilocks_bzero(random, sizeof(random));
+    goldilocks_bzero(pending, sizeof(pending));
+}
@@ -176,31 +176,50 @@ goldilocks_error_t API_NS(point_decode) (
     return goldilocks_succeed_if(mask_to_bool(succ));
 }
 
+goldilocks_error_t API_NS(point_decode_and_validate_batch) (
+    point_p out[],
+    goldilocks_bool_t successes[],
+    const unsigned char *ser,
+    size_t n,
+    goldilocks_bool_t allow_identity
+) {
+    goldilocks_bool_t all = GOLDILOCKS_TRUE;
+    size_t i;
+
+    for (i=0; i<n; i++) {
+        successes[i] = goldilocks_successful(API_NS(point_decode)(out[i], &ser[i*SER_BYTES], allow_identity));
+        /* Don't hand back garbage for the failures */
+        API_NS(point_cond_sel)(out[i], API_NS(point_identity), out[i], successes[i]);
+        all &= successes[i];
+    }
+    return goldilocks_succeed_if(all);
+}
+
 void API_NS(point_sub) (
     point_p p,
     const point_p q,
     const point_p r
 ) {
     gf a, b, c, d;
-    gf_sub_nr ( b, q->y, q->x ); /* 3+e */
-    gf_sub_nr ( d, r->y, r->x ); /* 3+e */
-    gf_add_nr ( c, r->y, r->x ); /* 2+e */
-    gf_mul ( a, c, b );
-    gf_add_nr ( b, q->y, q->x ); /* 2+e */
-    gf_mul ( p->y, d, b );
+    int ba, bb, bc, bd, by;
+    bb = gf_sub_bd ( b, q->y, 1, q->x, 1 );
+    bd = gf_sub_bd ( d, r->y, 1, r->x, 1 );
+    bc = gf_add_bd ( c, r->y, 1, r->x, 1 );
+    gf_mul_bd ( a, c, &bc, b, &bb );
+    bb = gf_add_bd ( b, q->y, 1, q->x, 1 );
+    gf_mul_bd ( p->y, d, &bd, b, &bb );
     gf_mul ( b, r->t, q->t );
     gf_mulw ( p->x, b, 2*EFF_D );
-    gf_add_nr ( b, a, p->y );    /* 2+e */
-    gf_sub_nr ( c, p->y, a );    /* 3+e */
+    bb = gf_add_bd ( b, a, 1, p->y, 1 );
+    bc = gf_sub_bd ( c, p->y, 1, a, 1 );
     gf_mul ( a, q->z, r->z );
-    gf_add_nr ( a, a, a );       /* 2+e */
-    if (GF_HEADROOM <= 3) gf_weak_reduce(a); /* or 1+e */
-    gf_sub_nr ( p->y, a, p->x ); /* 4+e or 3+e */
-    gf_add_nr ( a, a, p->x );    /* 3+e or 2+e */
-    gf_mul ( p->z, a, p->y );
-    gf_mul ( p->x, p->y, c );
-    gf_mul ( p->y, a, b );
-    gf_mul ( p->t, b, c );
+    ba = gf_add_bd ( a, a, 1, a, 1 );
+    by = gf_sub_bd ( p->y, a, ba, p->x, 1 );
+    ba = gf_add_bd ( a, a, ba, p->x, 1 );
+    gf_mul_bd ( p->z, a, &ba, p->y, &by );
+    gf_mul_bd ( p->x, p->y, &by, c, &bc );
+    gf_mul_bd ( p->y, a, &ba, b, &bb );
+    gf_mul_bd ( p->t, b, &bb, c, &bc );
 }
 
 void API_NS(point_add) (
@@ -209,25 +228,25 @@ void API_NS(point_add) (
     const point_p r
 ) {
     gf a, b, c, d;
-    gf_sub_nr ( b, q->y, q->x ); /* 3+e */
-    gf_sub_nr ( c, r->y, r->x ); /* 3+e */
-    gf_add_nr ( d, r->y, r->x ); /* 2+e */
-    gf_mul ( a, c, b );
-    gf_add_nr ( b, q->y, q->x ); /* 2+e */
-    gf_mul ( p->y, d, b );
+    int ba, bb, bc, bd, by;
+    bb = gf_sub_bd ( b, q->y, 1, q->x, 1 );
+    bc = gf_sub_bd ( c, r->y, 1, r->x, 1 );
+    bd = gf_add_bd ( d, r->y, 1, r->x, 1 );
+    gf_mul_bd ( a, c, &bc, b, &bb );
+    bb = gf_add_bd ( b, q->y, 1, q->x, 1 );
+    gf_mul_bd ( p->y, d, &bd, b, &bb );
     gf_mul ( b, r->t, q->t );
     gf_mulw ( p->x, b, 2*EFF_D );
-    gf_add_nr ( b, a, p->y );    /* 2+e */
-    gf_sub_nr ( c, p->y, a );    /* 3+e */
+    bb = gf_add_bd ( b, a, 1, p->y, 1 );
+    bc = gf_sub_bd ( c, p->y, 1, a, 1 );
     gf_mul ( a, q->z, r->z );
-    gf_add_nr ( a, a, a );       /* 2+e */
-    if (GF_HEADROOM <= 3) gf_weak_reduce(a); /* or 1+e */
-    gf_add_nr ( p->y, a, p->x ); /* 3+e or 2+e */
-    gf_sub_nr ( a, a, p->x );    /* 4+e or 3+e */
-    gf_mul ( p->z, a, p->y );
-    gf_mul ( p->x, p->y, c );
-    gf_mul ( p->y, a, b );
-    gf_mul ( p->t, b, c );
+    ba = gf_add_bd ( a, a, 1, a, 1 );
+    by = gf_add_bd ( p->y, a, ba, p->x, 1 );
+    ba = gf_sub_bd ( a, a, ba, p->x, 1 );
+    gf_mul_bd ( p->z, a, &ba, p->y, &by );
+    gf_mul_bd ( p->x, p->y, &by, c, &bc );
+    gf_mul_bd ( p->y, a, &ba, b, &bb );
+    gf_mul_bd ( p->t, b, &bb, c, &bc );
 }
 
 static GOLDILOCKS_NOINLINE void
@@ -237,21 +256,21 @@ point_double_internal (
     int before_double
 ) {
     gf a, b, c, d;
+    int ba, bb, bd, bt, bz;
     gf_sqr ( c, q->x );
     gf_sqr ( a, q->y );
-    gf_add_nr ( d, c, a );             /* 2+e */
-    gf_add_nr ( p->t, q->y, q->x );    /* 2+e */
-    gf_sqr ( b, p->t );
-    gf_subx_nr ( b, b, d, 3 );         /* 4+e */
-    gf_sub_nr ( p->t, a, c );          /* 3+e */
+    bd = gf_add_bd ( d, c, 1, a, 1 );
+    bt = gf_add_bd ( p->t, q->y, 1, q->x, 1 );
+    gf_sqr_bd ( b, p->t, &bt );
+    bb = gf_sub_bd ( b, b, 1, d, bd );
+    bt = gf_sub_bd ( p->t, a, 1, c, 1 );
     gf_sqr ( p->x, q->z );
-    gf_add_nr ( p->z, p->x, p->x );    /* 2+e */
-    gf_subx_nr ( a, p->z, p->t, 4 );   /* 6+e */
-    if (GF_HEADROOM == 5) gf_weak_reduce(a); /* or 1+e */
-    gf_mul ( p->x, a, b );
-    gf_mul ( p->z, p->t, a );
-    gf_mul ( p->y, p->t, d );
-    if (!before_double) gf_mul ( p->t, b, d );
+    bz = gf_add_bd ( p->z, p->x, 1, p->x, 1 );
+    ba = gf_sub_bd ( a, p->z, bz, p->t, bt );
+    gf_mul_bd ( p->x, a, &ba, b, &bb );
+    gf_mul_bd ( p->z, p->t, &bt, a, &ba );
+    gf_mul_bd ( p->y, p->t, &bt, d, &bd );
+    if (!before_double) gf_mul_bd ( p->t, b, &bb, d, &bd );
 }
 
 void API_NS(point_double)(point_p p, const point_p q) {
@@ -319,19 +338,20 @@ add_niels_to_pt (
     int before_double
 ) {
     gf a, b, c;
-    gf_sub_nr ( b, d->y, d->x ); /* 3+e */
+    int ba, bb, bc, by;
+    bb = gf_sub_bd ( b, d->y, 1, d->x, 1 );
     gf_mul ( a, e->a, b );
-    gf_add_nr ( b, d->x, d->y ); /* 2+e */
+    bb = gf_add_bd ( b, d->x, 1, d->y, 1 );
     gf_mul ( d->y, e->b, b );
     gf_mul ( d->x, e->c, d->t );
-    gf_add_nr ( c, a, d->y );    /* 2+e */
-    gf_sub_nr ( b, d->y, a );    /* 3+e */
-    gf_sub_nr ( d->y, d->z, d->x ); /* 3+e */
-    gf_add_nr ( a, d->x, d->z ); /* 2+e */
-    gf_mul ( d->z, a, d->y );
-    gf_mul ( d->x, d->y, b );
-    gf_mul ( d->y, a, c );
-    if (!before_double) gf_mul ( d->t, b, c );
+    bc = gf_add_bd ( c, a, 1, d->y, 1 );
+    bb = gf_sub_bd ( b, d->y, 1, a, 1 );
+    by = gf_sub_bd ( d->y, d->z, 1, d->x, 1 );
+    ba = gf_add_bd ( a, d->x, 1, d->z, 1 );
+    gf_mul_bd ( d->z, a, &ba, d->y, &by );
+    gf_mul_bd ( d->x, d->y, &by, b, &bb );
+    gf_mul_bd ( d->y, a, &ba, c, &bc );
+    if (!before_double) gf_mul_bd ( d->t, b, &bb, c, &bc );
 }
 
 static GOLDILOCKS_NOINLINE void
@@ -341,19 +361,20 @@ sub_niels_from_pt (
     int before_double
 ) {
     gf a, b, c;
-    gf_sub_nr ( b, d->y, d->x ); /* 3+e */
+    int ba, bb, bc, by;
+    bb = gf_sub_bd ( b, d->y, 1, d->x, 1 );
     gf_mul ( a, e->b, b );
-    gf_add_nr ( b, d->x, d->y ); /* 2+e */
+    bb = gf_add_bd ( b, d->x, 1, d->y, 1 );
     gf_mul ( d->y, e->a, b );
     gf_mul ( d->x, e->c, d->t );
-    gf_add_nr ( c, a, d->y );    /* 2+e */
-    gf_sub_nr ( b, d->y, a );    /* 3+e */
-    gf_add_nr ( d->y, d->z, d->x ); /* 2+e */
-    gf_sub_nr ( a, d->z, d->x ); /* 3+e */
-    gf_mul ( d->z, a, d->y );
-    gf_mul ( d->x, d->y, b );
-    gf_mul ( d->y, a, c );
-    if (!before_double) gf_mul ( d->t, b, c );
+    bc = gf_add_bd ( c, a, 1, d->y, 1 );
+    bb = gf_sub_bd ( b, d->y, 1, a, 1 );
+    by = gf_add_bd ( d->y, d->z, 1, d->x, 1 );
+    ba = gf_sub_bd ( a, d->z, 1, d->x, 1 );
+    gf_mul_bd ( d->z, a, &ba, d->y, &by );
+    gf_mul_bd ( d->x, d->y, &by, b, &bb );
+    gf_mul_bd ( d->y, a, &ba, c, &bc );
+    if (!before_double) gf_mul_bd ( d->t, b, &bb, c, &bc );
 }
 
 static void
@@ -380,6 +401,194 @@ sub_pniels_from_pt (
     sub_niels_from_pt( p, pn->n, before_double );
 }
 
+/*
+ * Working points for the scalar multiplication loops.  With GF_HAVE_VEC4 a
+ * working point holds (x,y,z,t) in the lanes of a gf4, and the formulas
+ * above are regrouped so that each doubling or addition is two 4-way
+ * multiplies.  The vector versions always compute t, since its lane is
+ * free, so they ignore before_double.
+ */
+#if GF_HAVE_VEC4
+#include "f_vec4.h"
+
+typedef gf4_s wpoint_s, wpoint_p[1];
+
+static GOLDILOCKS_INLINE void wpt_from_pt ( wpoint_p w, const point_p p ) {
+    gf4_pack(w, p->x, p->y, p->z, p->t);
+}
+
+static GOLDILOCKS_INLINE void wpt_to_pt ( point_p p, const wpoint_p w ) {
+    gf4_unpack(p->x, p->y, p->z, p->t, w);
+}
+
+static GOLDILOCKS_NOINLINE void
+wpt_double (
+    wpoint_p p,
+    int before_double
+) {
+    gf4 u, v, w, e;
+    (void)before_double;
+
+    /* (x, y, x+y, z)^2 = (C, A, (x+y)^2, Z^2) */
+    gf4_perm(u, p, GF4_LANES(0,1,0,2));
+    gf4_perm(v, p, GF4_LANES(0,1,1,2));
+    gf4_add_RAW(v, u, v);
+    gf4_blend(u, u, v, GF4_BLEND(0,0,1,0));
+    gf4_mul(p, u, u);
+
+    gf4_perm(u, p, GF4_LANES(0,1,1,0));     /* (C, A, A, C) */
+    gf4_perm(v, p, GF4_LANES(1,0,0,1));     /* (A, C, C, A) */
+    gf4_sub_RAW(w, u, v);
+    gf4_bias(w, 2);                         /* T = A-C in lane 1, bound 3 */
+    gf4_add_RAW(u, u, v);                   /* D = A+C, bound 2 */
+    gf4_perm(v, p, GF4_LANES(3,3,3,2));
+    gf4_add_RAW(e, v, v);
+    gf4_add_RAW(e, e, w);                   /* 2Z^2-T in lane 0, bound 5 */
+    gf4_sub_RAW(v, v, u);
+    gf4_bias(v, 3);                         /* E = (x+y)^2-D in lane 3, bound 4 */
+
+    gf4_blend(w, w, e, GF4_BLEND(1,0,0,0));
+    gf4_blend(w, w, u, GF4_BLEND(0,0,1,0));
+    gf4_blend(w, w, v, GF4_BLEND(0,0,0,1)); /* (2Z^2-T, T, D, E) */
+    gf4_weak_reduce(w);
+    gf4_perm(u, w, GF4_LANES(0,1,1,3));
+    gf4_perm(v, w, GF4_LANES(3,2,0,2));
+    gf4_mul(p, u, v);
+}
+
+/* Add n = (a,b,c,z) as in add_pniels_to_pt, or subtract if sub */
+static GOLDILOCKS_INLINE void
+wpt_add_n4 (
+    wpoint_p p,
+    const gf4 n,
+    int sub
+) {
+    gf4 u, v, w;
+
+    /* (y-x, y+x, t, z) * (a, b, c, z) */
+    gf4_perm(u, p, GF4_LANES(1,1,3,2));
+    gf4_perm(v, p, GF4_LANES(0,0,0,0));
+    gf4_sub_RAW(w, u, v);
+    gf4_bias(w, 2);
+    gf4_add_RAW(v, u, v);
+    gf4_blend(u, u, w, GF4_BLEND(1,0,0,0));
+    gf4_blend(u, u, v, GF4_BLEND(0,1,0,0));
+    gf4_mul(p, u, n);
+
+    gf4_perm(u, p, GF4_LANES(1,1,3,3));
+    gf4_perm(v, p, GF4_LANES(0,0,2,2));
+    gf4_add_RAW(w, u, v);                   /* bound 2 */
+    gf4_sub_RAW(u, u, v);
+    gf4_bias(u, 2);
+    gf4_weak_reduce(u);                     /* bound 1 */
+    if (sub) {
+        gf4_blend(u, u, w, GF4_BLEND(0,1,1,0));
+    } else {
+        gf4_blend(u, u, w, GF4_BLEND(0,1,0,1));
+    }
+    gf4_perm(v, u, GF4_LANES(0,1,2,1));
+    gf4_perm(w, u, GF4_LANES(2,3,3,0));
+    gf4_mul(p, w, v);
+}
+
+static GOLDILOCKS_NOINLINE void
+wpt_add_niels ( wpoint_p p, const niels_p n, int before_double ) {
+    gf4 n4;
+    (void)before_double;
+    gf4_pack(n4, n->a, n->b, n->c, ONE);
+    wpt_add_n4(p, n4, 0);
+}
+
+static GOLDILOCKS_NOINLINE void
+wpt_sub_niels ( wpoint_p p, const niels_p n, int before_double ) {
+    gf4 n4;
+    (void)before_double;
+    gf4_pack(n4, n->b, n->a, n->c, ONE);
+    wpt_add_n4(p, n4, 1);
+}
+
+static GOLDILOCKS_NOINLINE void
+wpt_add_pniels ( wpoint_p p, const pniels_p pn, int before_double ) {
+    gf4 n4;
+    (void)before_double;
+    gf4_pack(n4, pn->n->a, pn->n->b, pn->n->c, pn->z);
+    wpt_add_n4(p, n4, 0);
+}
+
+static GOLDILOCKS_NOINLINE void
+wpt_sub_pniels ( wpoint_p p, const pniels_p pn, int before_double ) {
+    gf4 n4;
+    (void)before_double;
+    gf4_pack(n4, pn->n->b, pn->n->a, pn->n->c, pn->z);
+    wpt_add_n4(p, n4, 1);
+}
+
+static void wpt_from_niels ( wpoint_p w, const niels_p n ) {
+    point_p p;
+    niels_to_pt(p, n);
+    wpt_from_pt(w, p);
+    goldilocks_bzero(p,sizeof(p));
+}
+
+static void wpt_from_pniels ( wpoint_p w, const pniels_p pn ) {
+    point_p p;
+    pniels_to_pt(p, pn);
+    wpt_from_pt(w, p);
+    goldilocks_bzero(p,sizeof(p));
+}
+#else
+typedef API_NS(point_s) wpoint_s, wpoint_p[1];
+
+static GOLDILOCKS_INLINE void wpt_from_pt ( wpoint_p w, const point_p p ) {
+    API_NS(point_copy)(w, p);
+}
+
+static GOLDILOCKS_INLINE void wpt_to_pt ( point_p p, const wpoint_p w ) {
+    API_NS(point_copy)(p, w);
+}
+
+static GOLDILOCKS_INLINE void wpt_double ( wpoint_p p, int before_double ) {
+    point_double_internal(p, p, before_double);
+}
+
+#define wpt_add_niels   add_niels_to_pt
+#define wpt_sub_niels   sub_niels_from_pt
+#define wpt_add_pniels  add_pniels_to_pt
+#define wpt_sub_pniels  sub_pniels_from_pt
+#define wpt_from_niels  niels_to_pt
+#define wpt_from_pniels pniels_to_pt
+#endif
+
+/* The public prepared point is a pniels under another name */
+typedef char prepared_point_is_pniels[
+    (sizeof(API_NS(prepared_point_s)) == sizeof(pniels_s)) ? 1 : -1
+];
+
+void API_NS(point_prepare) (
+    API_NS(prepared_point_p) out,
+    const point_p p
+) {
+    pt_to_pniels((pniels_s *)out, p);
+}
+
+void API_NS(point_add_prepared) (
+    point_p sum,
+    const point_p a,
+    const API_NS(prepared_point_p) b
+) {
+    API_NS(point_copy)(sum, a);
+    add_pniels_to_pt(sum, (const pniels_s *)b, 0);
+}
+
+void API_NS(point_sub_prepared) (
+    point_p diff,
+    const point_p a,
+    const API_NS(prepared_point_p) b
+) {
+    API_NS(point_copy)(diff, a);
+    sub_pniels_from_pt(diff, (const pniels_s *)b, 0);
+}
+
 static GOLDILOCKS_NOINLINE void
 prepare_fixed_window(
     pniels_p *multiples,
@@ -415,7 +624,7 @@ void API_NS(point_scalarmul) (
 
     scalar_p scalar1x;
     pniels_p pn, multiples[NTABLE];
-    point_p tmp;
+    wpoint_p tmp;
     int i,j,first=1;
 
     API_NS(scalar_add)(scalar1x, scalar, point_scalarmul_adjustment);
@@ -442,7 +651,7 @@ void API_NS(point_scalarmul) (
         constant_time_lookup(pn, multiples, sizeof(pn), NTABLE, bits & WINDOW_T_MASK);
         cond_neg_niels(pn->n, inv);
         if (first) {
-            pniels_to_pt(tmp, pn);
+            wpt_from_pniels(tmp, pn);
             first = 0;
         } else {
            /* Using Hisil et al's lookahead method instead of extensible here
@@ -450,14 +659,14 @@ void API_NS(point_scalarmul) (
             * the last one.
             */
             for (j=0; j<WINDOW-1; j++)
-                point_double_internal(tmp, tmp, -1);
-            point_double_internal(tmp, tmp, 0);
-            add_pniels_to_pt(tmp, pn, i ? -1 : 0);
+                wpt_double(tmp, -1);
+            wpt_double(tmp, 0);
+            wpt_add_pniels(tmp, pn, i ? -1 : 0);
         }
     }
 
     /* Write out the answer */
-    API_NS(point_copy)(a,tmp);
+    wpt_to_pt(a,tmp);
 
     goldilocks_bzero(scalar1x,sizeof(scalar1x));
     goldilocks_bzero(pn,sizeof(pn));
@@ -726,15 +935,13 @@ static void gf_batch_invert (
     }
 }
 
-static void batch_normalize_niels (
+static void normalize_niels (
     niels_p *table,
-    const gf *zs,
-    gf *__restrict__ zis,
+    const gf *zis,
     int n
 ) {
     int i;
     gf product;
-    gf_batch_invert(zis, zs, n);
 
     for (i=0; i<n; i++) {
         gf_mul(product, table[i]->a, zis[i]);
@@ -753,14 +960,79 @@ static void batch_normalize_niels (
     goldilocks_bzero(product,sizeof(product));
 }
 
-void API_NS(precompute) (
+static void batch_normalize_niels (
+    niels_p *table,
+    const gf *zs,
+    gf *__restrict__ zis,
+    int n
+) {
+    gf_batch_invert(zis, zs, n);
+    normalize_niels(table, (const gf *)zis, n);
+}
+
+/* Points normalized per batch inversion by points_normalize_batch */
+#define NORMALIZE_BATCH 128
+
+void API_NS(points_normalize_batch) (
+    point_p out[],
+    const point_p in[],
+    size_t n
+) {
+    gf zs[NORMALIZE_BATCH], zis[NORMALIZE_BATCH], product;
+    size_t i, todo;
+
+    for (; n; n -= todo, in += todo, out += todo) {
+        todo = (n > NORMALIZE_BATCH) ? NORMALIZE_BATCH : n;
+        for (i=0; i<todo; i++) gf_copy(zs[i], in[i]->z);
+        if (todo > 1) {
+            gf_batch_invert(zis, (const gf *)zs, todo);
+        } else {
+            gf_invert(zis[0], zs[0], 1);
+        }
+
+        for (i=0; i<todo; i++) {
+            gf_mul(product, in[i]->x, zis[i]);
+            gf_copy(out[i]->x, product);
+            gf_mul(product, in[i]->y, zis[i]);
+            gf_copy(out[i]->y, product);
+            gf_mul(product, in[i]->t, zis[i]);
+            gf_copy(out[i]->t, product);
+            gf_copy(out[i]->z, ONE);
+        }
+    }
+}
+
+void API_NS(point_sum) (
+    point_p out,
+    const point_p pts[],
+    size_t n
+) {
+    /* Normalizing the points first doesn't pay: it costs more multiplies than
+     * the Z*Z' product which affine additions would save, and with four lanes
+     * that product comes free anyway.  Keep the sum in the wide form instead. */
+    wpoint_p acc;
+    pniels_p pn;
+    size_t i;
+
+    wpt_from_pt(acc, API_NS(point_identity));
+    for (i=0; i<n; i++) {
+        pt_to_pniels(pn, pts[i]);
+        wpt_add_pniels(acc, pn, 0);
+    }
+    wpt_to_pt(out, acc);
+    goldilocks_bzero(pn, sizeof(pn));
+    goldilocks_bzero(acc, sizeof(acc));
+}
+
+/* Build a comb table for base, leaving each entry scaled by zs[entry] */
+static void precompute_unnormalized (
     precomputed_s *table,
+    gf *zs,
     const point_p base
 ) {
     const unsigned int n = COMBS_N, t = COMBS_T, s = COMBS_S;
-    point_p working, start, doubles[t-1];
-    pniels_p pn_tmp;
-    gf zs[n<<(t-1)], zis[n<<(t-1)];
+    point_p working, start;
+    pniels_p pn_tmp, doubles[t-1];
     unsigned int i,j,k;
 
     assert(n*t*s >= SCALAR_BITS);
@@ -778,13 +1050,15 @@ void API_NS(precompute) (
             if (j==t-1 && i==n-1) break;
 
             point_double_internal(working, working,0);
-            if (j<t-1) API_NS(point_copy)(doubles[j], working);
+            if (j<t-1) pt_to_pniels(doubles[j], working);
 
             for (k=0; k<s-1; k++)
                 point_double_internal(working, working, k<s-2);
         }
 
-        /* Gray-code phase */
+        /* Gray-code phase.  The doubles are each used several times, so
+         * they are kept as pniels rather than converted on every add.
+         */
         for (j=0;; j++) {
             int gray = j ^ (j>>1);
             int idx = (((i+1)<<(t-1))-1) ^ gray;
@@ -801,23 +1075,55 @@ void API_NS(precompute) (
                 delta >>=1;
 
             if (gray & (1<<k)) {
-                API_NS(point_add)(start, start, doubles[k]);
+                add_pniels_to_pt(start, doubles[k], 0);
             } else {
-                API_NS(point_sub)(start, start, doubles[k]);
+                sub_pniels_from_pt(start, doubles[k], 0);
             }
         }
     }
 
-    batch_normalize_niels(table->table,(const gf *)zs,zis,n<<(t-1));
-
-    goldilocks_bzero(zs,sizeof(zs));
-    goldilocks_bzero(zis,sizeof(zis));
     goldilocks_bzero(pn_tmp,sizeof(pn_tmp));
     goldilocks_bzero(working,sizeof(working));
     goldilocks_bzero(start,sizeof(start));
     goldilocks_bzero(doubles,sizeof(doubles));
 }
 
+void API_NS(precompute) (
+    precomputed_s *table,
+    const point_p base
+) {
+    gf zs[COMBS_N<<(COMBS_T-1)], zis[COMBS_N<<(COMBS_T-1)];
+
+    precompute_unnormalized(table, zs, base);
+    batch_normalize_niels(table->table,(const gf *)zs,zis,COMBS_N<<(COMBS_T-1));
+
+    goldilocks_bzero(zs,sizeof(zs));
+    goldilocks_bzero(zis,sizeof(zis));
+}
+
+/* Tables built per shared inversion by precompute_batch */
+#define PRECOMPUTE_BATCH 4
+
+void API_NS(precompute_batch) (
+    precomputed_s *const tables[],
+    const point_p bases[],
+    size_t n
+) {
+    const unsigned int entries = COMBS_N<<(COMBS_T-1);
+    gf zs[PRECOMPUTE_BATCH*(COMBS_N<<(COMBS_T-1))], zis[PRECOMPUTE_BATCH*(COMBS_N<<(COMBS_T-1))];
+    size_t i, todo;
+
+    for (; n; n -= todo, tables += todo, bases += todo) {
+        todo = (n > PRECOMPUTE_BATCH) ? PRECOMPUTE_BATCH : n;
+        for (i=0; i<todo; i++) precompute_unnormalized(tables[i], &zs[i*entries], bases[i]);
+        gf_batch_invert(zis, (const gf *)zs, todo*entries);
+        for (i=0; i<todo; i++) normalize_niels(tables[i]->table, (const gf *)&zis[i*entries], entries);
+    }
+
+    goldilocks_bzero(zs,sizeof(zs));
+    goldilocks_bzero(zis,sizeof(zis));
+}
+
 static GOLDILOCKS_INLINE void
 constant_time_lookup_niels (
     niels_s *__restrict__ ni,
@@ -839,13 +1145,14 @@ void API_NS(precomputed_scalarmul) (
 
     scalar_p scalar1x;
     niels_p ni;
+    wpoint_p acc;
 
     API_NS(scalar_add)(scalar1x, scalar, precomputed_scalarmul_adjustment);
     API_NS(scalar_halve)(scalar1x,scalar1x);
 
 
     for (i=s-1; i>=0; i--) {
-        if (i != (int)s-1) point_double_internal(out,out,0);
+        if (i != (int)s-1) wpt_double(acc,0);
 
         for (j=0; j<n; j++) {
             int tab = 0;
@@ -866,14 +1173,17 @@ void API_NS(precomputed_scalarmul) (
 
             cond_neg_niels(ni, invert);
             if ((i!=(int)s-1)||j) {
-                add_niels_to_pt(out, ni, j==n-1 && i);
+                wpt_add_niels(acc, ni, j==n-1 && i);
             } else {
-                niels_to_pt(out, ni);
+                wpt_from_niels(acc, ni);
             }
         }
     }
 
+    wpt_to_pt(out, acc);
+
     goldilocks_bzero(ni,sizeof(ni));
+    goldilocks_bzero(acc,sizeof(acc));
     goldilocks_bzero(scalar1x,sizeof(scalar1x));
 }
 
@@ -1004,62 +1314,169 @@ goldilocks_error_t API_NS(point_decode_like_eddsa_and_mul_by_ratio) (
     return goldilocks_succeed_if(mask_to_bool(succ));
 }
 
-goldilocks_error_t goldilocks_x448 (
-    uint8_t out[X_PUBLIC_BYTES],
-    const uint8_t base[X_PUBLIC_BYTES],
+/* Bit t of the conditioned X448 scalar, as a mask */
+static GOLDILOCKS_INLINE mask_t x448_scalar_bit (
+    const uint8_t scalar[X_PRIVATE_BYTES],
+    int t
+) {
+    uint8_t sb = scalar[t/8];
+    mask_t k_t;
+
+    /* Scalar conditioning */
+    if (t/8==0) sb &= -(uint8_t)COFACTOR;
+    else if (t == X_PRIVATE_BITS-1) sb = -1;
+
+    k_t = (sb>>(t%8)) & 1;
+    return -k_t; /* set to all 0s or all 1s */
+}
+
+#if GF_HAVE_VEC2
+#include "f_vec2.h"
+
+/* The ladder with (x2,x3) and (z2,z3) held in the lanes of 2-way vectors.
+ * Each step's independent products are paired: DA with CB, AA with BB,
+ * the squares of DA+CB and DA-CB, and the new x2 with the new z2.  The
+ * fifth multiply, by (1,x1), turns ((DA+CB)^2, (DA-CB)^2) into (x3,z3).
+ * Five 2-way multiplies replace nine scalar ones.
+ */
+static void x448_ladder (
+    gf x2,
+    gf z2,
+    const gf x1,
     const uint8_t scalar[X_PRIVATE_BYTES]
 ) {
-    gf x1, x2, z2, x3, z3, t1, t2;
+    gf2 xx, zz, one_x1, ac, bd, u, v, w, p, q;
     int t;
-    mask_t swap = 0, nz = 0;
-    ignore_result(gf_deserialize(x1,base,1,0));
+    mask_t swap = 0, k_t;
+
+    gf2_pack(xx, ONE, x1);
+    gf2_pack(zz, ZERO, ONE);
+    gf2_pack(one_x1, ONE, x1);
+
+    for (t = X_PRIVATE_BITS-1; t>=0; t--) {
+        k_t = x448_scalar_bit(scalar, t);
+        swap ^= k_t;
+        gf2_cond_swap_lanes(xx,swap);
+        gf2_cond_swap_lanes(zz,swap);
+        swap = k_t;
+
+        /* Bounds are as in gf_mul_bd, lane by lane */
+        gf2_add_RAW(ac,xx,zz);      /* (A,C), bound 2 */
+        gf2_sub_RAW(bd,xx,zz);
+        gf2_bias(bd,2);             /* (B,D), bound 3 */
+        gf2_swap_lanes(u,bd);       /* (D,B) */
+        gf2_mul(p,ac,u);            /* (DA,CB) */
+        gf2_lo_lo(u,ac,bd);         /* (A,B), bound 3 */
+        gf2_weak_reduce(u);
+        gf2_mul(q,u,u);             /* (AA,BB) */
+
+        gf2_lo_lo(u,p,p);           /* (DA,DA) */
+        gf2_hi_hi(v,p,p);           /* (CB,CB) */
+        gf2_add_RAW(w,u,v);
+        gf2_sub_RAW(u,u,v);
+        gf2_bias(u,2);
+        gf2_lo_lo(v,w,u);           /* (DA+CB,DA-CB), bound 3 */
+        gf2_weak_reduce(v);
+        gf2_mul(w,v,v);
+        gf2_mul(p,w,one_x1);        /* (x3,z3) */
+
+        gf2_swap_lanes(u,q);        /* (BB,AA) */
+        gf2_sub_RAW(v,q,u);
+        gf2_bias(v,2);              /* E = AA-BB in the low lane, bound 3 */
+        gf2_mulw_unsigned(w,v,-EDWARDS_D);
+        gf2_add_RAW(w,w,q);         /* AA + a24*E in the low lane, bound 2 */
+        gf2_lo_lo(ac,q,v);          /* (AA,E) */
+        gf2_lo_lo(bd,u,w);          /* (BB,AA+a24*E) */
+        gf2_mul(q,ac,bd);           /* (x2,z2) */
+
+        gf2_lo_lo(xx,q,p);
+        gf2_hi_hi(zz,q,p);
+    }
+
+    gf2_cond_swap_lanes(xx,swap);
+    gf2_cond_swap_lanes(zz,swap);
+    gf2_lo(x2,xx);
+    gf2_lo(z2,zz);
+
+    goldilocks_bzero(xx,sizeof(xx));
+    goldilocks_bzero(zz,sizeof(zz));
+    goldilocks_bzero(ac,sizeof(ac));
+    goldilocks_bzero(bd,sizeof(bd));
+    goldilocks_bzero(u,sizeof(u));
+    goldilocks_bzero(v,sizeof(v));
+    goldilocks_bzero(w,sizeof(w));
+    goldilocks_bzero(p,sizeof(p));
+    goldilocks_bzero(q,sizeof(q));
+}
+#else
+/* Montgomery ladder, returning x2 and z2 */
+static void x448_ladder (
+    gf x2,
+    gf z2,
+    const gf x1,
+    const uint8_t scalar[X_PRIVATE_BYTES]
+) {
+    gf x3, z3, t1, t2;
+    int t;
+    mask_t swap = 0, k_t;
     gf_copy(x2,ONE);
     gf_copy(z2,ZERO);
     gf_copy(x3,x1);
     gf_copy(z3,ONE);
 
-
     for (t = X_PRIVATE_BITS-1; t>=0; t--) {
-        uint8_t sb = scalar[t/8];
-        mask_t k_t;
-
-        /* Scalar conditioning */
-        if (t/8==0) sb &= -(uint8_t)COFACTOR;
-        else if (t == X_PRIVATE_BITS-1) sb = -1;
-
-        k_t = (sb>>(t%8)) & 1;
-        k_t = -k_t; /* set to all 0s or all 1s */
+        int bt1, bt2, bz2, bz3;
 
+        k_t = x448_scalar_bit(scalar, t);
         swap ^= k_t;
         gf_cond_swap(x2,x3,swap);
         gf_cond_swap(z2,z3,swap);
         swap = k_t;
 
-        gf_add_nr(t1,x2,z2); /* A = x2 + z2 */        /* 2+e */
-        gf_sub_nr(t2,x2,z2); /* B = x2 - z2 */        /* 3+e */
-        gf_sub_nr(z2,x3,z3); /* D = x3 - z3 */        /* 3+e */
-        gf_mul(x2,t1,z2);    /* DA */
-        gf_add_nr(z2,z3,x3); /* C = x3 + z3 */        /* 2+e */
-        gf_mul(x3,t2,z2);    /* CB */
-        gf_sub_nr(z3,x2,x3); /* DA-CB */              /* 3+e */
-        gf_sqr(z2,z3);       /* (DA-CB)^2 */
-        gf_mul(z3,x1,z2);    /* z3 = x1(DA-CB)^2 */
-        gf_add_nr(z2,x2,x3); /* (DA+CB) */            /* 2+e */
-        gf_sqr(x3,z2);       /* x3 = (DA+CB)^2 */
-
-        gf_sqr(z2,t1);       /* AA = A^2 */
-        gf_sqr(t1,t2);       /* BB = B^2 */
-        gf_mul(x2,z2,t1);    /* x2 = AA*BB */
-        gf_sub_nr(t2,z2,t1); /* E = AA-BB */          /* 3+e */
-
-        gf_mulw(t1,t2,-EDWARDS_D); /* E*-d = a24*E */
-        gf_add_nr(t1,t1,z2); /* AA + a24*E */         /* 2+e */
-        gf_mul(z2,t2,t1); /* z2 = E(AA+a24*E) */
+        /* x2, z2, x3 and z3 come out of gf_mul, so they start at bound 1 */
+        bt1 = gf_add_bd(t1,x2,1,z2,1); /* A = x2 + z2 */
+        bt2 = gf_sub_bd(t2,x2,1,z2,1); /* B = x2 - z2 */
+        bz2 = gf_sub_bd(z2,x3,1,z3,1); /* D = x3 - z3 */
+        gf_mul_bd(x2,t1,&bt1,z2,&bz2); /* DA */
+        bz2 = gf_add_bd(z2,z3,1,x3,1); /* C = x3 + z3 */
+        gf_mul_bd(x3,t2,&bt2,z2,&bz2); /* CB */
+        bz3 = gf_sub_bd(z3,x2,1,x3,1); /* DA-CB */
+        gf_sqr_bd(z2,z3,&bz3);         /* (DA-CB)^2 */
+        gf_mul(z3,x1,z2);              /* z3 = x1(DA-CB)^2 */
+        bz2 = gf_add_bd(z2,x2,1,x3,1); /* (DA+CB) */
+        gf_sqr_bd(x3,z2,&bz2);         /* x3 = (DA+CB)^2 */
+
+        gf_sqr_bd(z2,t1,&bt1);         /* AA = A^2 */
+        gf_sqr_bd(t1,t2,&bt2);         /* BB = B^2 */
+        gf_mul(x2,z2,t1);              /* x2 = AA*BB */
+        bt2 = gf_sub_bd(t2,z2,1,t1,1); /* E = AA-BB */
+
+        gf_mulw(t1,t2,-EDWARDS_D);     /* E*-d = a24*E */
+        bt1 = gf_add_bd(t1,t1,1,z2,1); /* AA + a24*E */
+        gf_mul_bd(z2,t2,&bt2,t1,&bt1); /* z2 = E(AA+a24*E) */
     }
 
-    /* Finish */
     gf_cond_swap(x2,x3,swap);
     gf_cond_swap(z2,z3,swap);
+
+    goldilocks_bzero(x3,sizeof(x3));
+    goldilocks_bzero(z3,sizeof(z3));
+    goldilocks_bzero(t1,sizeof(t1));
+    goldilocks_bzero(t2,sizeof(t2));
+}
+#endif
+
+goldilocks_error_t goldilocks_x448 (
+    uint8_t out[X_PUBLIC_BYTES],
+    const uint8_t base[X_PUBLIC_BYTES],
+    const uint8_t scalar[X_PRIVATE_BYTES]
+) {
+    gf x1, x2, z2;
+    mask_t nz;
+    ignore_result(gf_deserialize(x1,base,1,0));
+    x448_ladder(x2,z2,x1,scalar);
+
+    /* Finish */
     gf_invert(z2,z2,0);
     gf_mul(x1,x2,z2);
     gf_serialize(out,x1,1);
@@ -1068,10 +1485,6 @@ goldilocks_error_t goldilocks_x448 (
     goldilocks_bzero(x1,sizeof(x1));
     goldilocks_bzero(x2,sizeof(x2));
     goldilocks_bzero(z2,sizeof(z2));
-    goldilocks_bzero(x3,sizeof(x3));
-    goldilocks_bzero(z3,sizeof(z3));
-    goldilocks_bzero(t1,sizeof(t1));
-    goldilocks_bzero(t2,sizeof(t2));
 
     return goldilocks_succeed_if(mask_to_bool(nz));
 }
@@ -1141,6 +1554,66 @@ void goldilocks_x448_derive_public_key (
     API_NS(point_destroy)(p);
 }
 
+struct x448_batch {
+    uint8_t *out;
+    goldilocks_bool_t *successes;
+    const uint8_t *bases, *scalars;
+};
+
+static void x448_batch_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct x448_batch *b = (const struct x448_batch *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i=first; i<first+count; i++) {
+        b->successes[i] = goldilocks_successful(goldilocks_x448(
+            &b->out[i*X_PUBLIC_BYTES], &b->bases[i*X_PUBLIC_BYTES], &b->scalars[i*X_PRIVATE_BYTES]
+        ));
+    }
+}
+
+static void x448_derive_public_key_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct x448_batch *b = (const struct x448_batch *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i=first; i<first+count; i++) {
+        goldilocks_x448_derive_public_key(&b->out[i*X_PUBLIC_BYTES], &b->scalars[i*X_PRIVATE_BYTES]);
+    }
+}
+
+goldilocks_error_t goldilocks_x448_batch (
+    uint8_t *shared,
+    goldilocks_bool_t successes[],
+    const uint8_t *bases,
+    const uint8_t *scalars,
+    size_t n,
+    goldilocks_pool_s *pool
+) {
+    struct x448_batch b;
+    goldilocks_bool_t all = GOLDILOCKS_TRUE;
+    size_t i;
+    b.out = shared;
+    b.successes = successes;
+    b.bases = bases;
+    b.scalars = scalars;
+    (void)goldilocks_pool_run(pool, n, 0, 0, x448_batch_task, &b);
+    for (i=0; i<n; i++) all &= successes[i];
+    return goldilocks_succeed_if(all);
+}
+
+void goldilocks_x448_derive_public_key_batch (
+    uint8_t *out,
+    const uint8_t *scalars,
+    size_t n,
+    goldilocks_pool_s *pool
+) {
+    struct x448_batch b;
+    b.out = out;
+    b.successes = NULL;
+    b.bases = NULL;
+    b.scalars = scalars;
+    (void)goldilocks_pool_run(pool, n, 0, 0, x448_derive_public_key_task, &b);
+}
+
 /**
  * @cond internal
  * Control for variable-time scalar multiply algorithms.
@@ -1267,6 +1740,7 @@ void API_NS(base_double_scalarmul_non_secret) (
     const int table_bits_var = GOLDILOCKS_WNAF_VAR_TABLE_BITS,
         table_bits_pre = GOLDILOCKS_WNAF_FIXED_TABLE_BITS;
     int contp=0, contv=0, i;
+    wpoint_p acc;
     struct smvt_control control_var[SCALAR_BITS/(table_bits_var+1)+3];
     struct smvt_control control_pre[SCALAR_BITS/(table_bits_pre+1)+3];
 
@@ -1282,29 +1756,29 @@ void API_NS(base_double_scalarmul_non_secret) (
         API_NS(point_copy)(combo, API_NS(point_identity));
         return;
     } else if (i > control_pre[0].power) {
-        pniels_to_pt(combo, precmp_var[control_var[0].addend >> 1]);
+        wpt_from_pniels(acc, precmp_var[control_var[0].addend >> 1]);
         contv++;
     } else if (i == control_pre[0].power && i >=0 ) {
-        pniels_to_pt(combo, precmp_var[control_var[0].addend >> 1]);
-        add_niels_to_pt(combo, API_NS(wnaf_base)[control_pre[0].addend >> 1], i);
+        wpt_from_pniels(acc, precmp_var[control_var[0].addend >> 1]);
+        wpt_add_niels(acc, API_NS(wnaf_base)[control_pre[0].addend >> 1], i);
         contv++; contp++;
     } else {
         i = control_pre[0].power;
-        niels_to_pt(combo, API_NS(wnaf_base)[control_pre[0].addend >> 1]);
+        wpt_from_niels(acc, API_NS(wnaf_base)[control_pre[0].addend >> 1]);
         contp++;
     }
 
     for (i--; i >= 0; i--) {
         int cv = (i==control_var[contv].power), cp = (i==control_pre[contp].power);
-        point_double_internal(combo,combo,i && !(cv||cp));
+        wpt_double(acc,i && !(cv||cp));
 
         if (cv) {
             assert(control_var[contv].addend);
 
             if (control_var[contv].addend > 0) {
-                add_pniels_to_pt(combo, precmp_var[control_var[contv].addend >> 1], i&&!cp);
+                wpt_add_pniels(acc, precmp_var[control_var[contv].addend >> 1], i&&!cp);
             } else {
-                sub_pniels_from_pt(combo, precmp_var[(-control_var[contv].addend) >> 1], i&&!cp);
+                wpt_sub_pniels(acc, precmp_var[(-control_var[contv].addend) >> 1], i&&!cp);
             }
             contv++;
         }
@@ -1313,14 +1787,16 @@ void API_NS(base_double_scalarmul_non_secret) (
             assert(control_pre[contp].addend);
 
             if (control_pre[contp].addend > 0) {
-                add_niels_to_pt(combo, API_NS(wnaf_base)[control_pre[contp].addend >> 1], i);
+                wpt_add_niels(acc, API_NS(wnaf_base)[control_pre[contp].addend >> 1], i);
             } else {
-                sub_niels_from_pt(combo, API_NS(wnaf_base)[(-control_pre[contp].addend) >> 1], i);
+                wpt_sub_niels(acc, API_NS(wnaf_base)[(-control_pre[contp].addend) >> 1], i);
             }
             contp++;
         }
     }
 
+    wpt_to_pt(combo, acc);
+
     /* This function is non-secret, but whatever this is cheap. */
     goldilocks_bzero(control_var,sizeof(control_var));
     goldilocks_bzero(control_pre,sizeof(control_pre));
@@ -1336,6 +1812,12 @@ void API_NS(point_destroy) (
     goldilocks_bzero(point, sizeof(point_p));
 }
 
+void API_NS(prepared_point_destroy) (
+    API_NS(prepared_point_p) pt
+) {
+    goldilocks_bzero(pt, sizeof(API_NS(prepared_point_p)));
+}
+
 void API_NS(precomputed_destroy) (
     precomputed_s *pre
 ) {
@@ -295,6 +295,34 @@ static __inline__ void mrs(__uint128_t *acc, const uint64_t *a, const uint64_t *
   *acc = (((__uint128_t)(d))<<64) | c;
 }
 
+/* acc0 += a0*b0 and acc1 += a1*b1, carrying through CF and OF respectively
+ * so that the two chains can overlap.  Needs BMI2 and ADX; the asm is not
+ * volatile, so the compiler is free to schedule it.
+ */
+static __inline__ void mac_adx2(
+    __uint128_t *acc0, uint64_t a0, uint64_t b0,
+    __uint128_t *acc1, uint64_t a1, uint64_t b1
+) {
+  uint64_t lo0 = *acc0, hi0 = *acc0>>64, lo1 = *acc1, hi1 = *acc1>>64;
+  uint64_t c0, d0, c1, d1;
+  __asm__
+      ("movq %[a0], %%rdx; "
+       "mulx %[b0], %[c0], %[d0]; "
+       "movq %[a1], %%rdx; "
+       "mulx %[b1], %[c1], %[d1]; "
+       "xorl %%edx, %%edx; "
+       "adcx %[c0], %[lo0]; "
+       "adox %[c1], %[lo1]; "
+       "adcx %[d0], %[hi0]; "
+       "adox %[d1], %[hi1]; "
+       : [c0]"=&r"(c0), [d0]"=&r"(d0), [c1]"=&r"(c1), [d1]"=&r"(d1),
+         [lo0]"+r"(lo0), [hi0]"+r"(hi0), [lo1]"+r"(lo1), [hi1]"+r"(hi1)
+       : [a0]"rm"(a0), [b0]"rm"(b0), [a1]"rm"(a1), [b1]"rm"(b1)
+       : "rdx", "cc");
+  *acc0 = (((__uint128_t)(hi0))<<64) | lo0;
+  *acc1 = (((__uint128_t)(hi1))<<64) | lo1;
+}
+
 static __inline__ uint64_t word_is_zero(uint64_t x) {
   __asm__ volatile("neg %0; sbb %0, %0;" : "+r"(x));
   return ~x;
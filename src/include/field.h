@@ -53,6 +53,77 @@ static inline void gf_subx_nr ( gf c, const gf a, const gf b, int amt ) {
     if (GF_HEADROOM < amt+1) gf_weak_reduce(c);
 }
 
+/*
+ * Bound-tracked arithmetic for the curve formulas.
+ *
+ * The bound of an element is how many times the width of a weakly reduced
+ * limb its limbs may reach, so outputs of gf_mul, gf_mulw and
+ * gf_weak_reduce have bound 1.  The helpers take the bounds of their
+ * inputs, return or update the bounds of their outputs, and weakly reduce
+ * only where the backend's limits would otherwise be exceeded.  Formulas
+ * pass literal bounds, so once the helpers are inlined every decision is
+ * made at compile time.
+ *
+ * A backend may set in f_impl.h:
+ *   GF_LIMB_BOUND  the largest bound an element may be stored with; it
+ *                  must also be acceptable to gf_mulw_unsigned.
+ *   GF_MUL_BOUND   the largest product of input bounds gf_mul accepts.
+ * The defaults keep every input of gf_mul within GF_HEADROOM.
+ *
+ * Since GF_MUL_BOUND >= GF_LIMB_BOUND, multiplying any stored element by
+ * one of bound 1 is always safe, and plain gf_mul is used for that.
+ */
+#ifndef GF_LIMB_BOUND
+#define GF_LIMB_BOUND GF_HEADROOM
+#endif
+#ifndef GF_MUL_BOUND
+#define GF_MUL_BOUND (GF_LIMB_BOUND*GF_LIMB_BOUND)
+#endif
+#if GF_MUL_BOUND < GF_LIMB_BOUND
+#error "GF_MUL_BOUND must be at least GF_LIMB_BOUND"
+#endif
+
+/** Weakly reduce x if its bound is too large to store.  Return its bound. */
+static GOLDILOCKS_INLINE int gf_fit_bd ( gf x, int bx ) {
+    if (bx > GF_LIMB_BOUND) {
+        gf_weak_reduce(x);
+        return 1;
+    }
+    return bx;
+}
+
+/** c = a+b, where a and b have bounds ba and bb.  Return c's bound. */
+static GOLDILOCKS_INLINE int gf_add_bd ( gf c, const gf a, int ba, const gf b, int bb ) {
+    gf_add_RAW(c,a,b);
+    return gf_fit_bd(c, ba+bb);
+}
+
+/** c = a-b, where a and b have bounds ba and bb.  Return c's bound. */
+static GOLDILOCKS_INLINE int gf_sub_bd ( gf c, const gf a, int ba, const gf b, int bb ) {
+    gf_sub_RAW(c,a,b);
+    gf_bias(c, bb+1);
+    return gf_fit_bd(c, ba+bb+1);
+}
+
+/** c = a*b, first weakly reducing a or b if their bounds are too large. */
+static GOLDILOCKS_INLINE void gf_mul_bd ( gf_s *__restrict__ c, gf a, int *ba, gf b, int *bb ) {
+    if (*ba * *bb > GF_MUL_BOUND) {
+        if (*ba >= *bb) { gf_weak_reduce(a); *ba = 1; }
+        else            { gf_weak_reduce(b); *bb = 1; }
+    }
+    if (*ba * *bb > GF_MUL_BOUND) {
+        if (*ba > 1) { gf_weak_reduce(a); *ba = 1; }
+        else         { gf_weak_reduce(b); *bb = 1; }
+    }
+    gf_mul(c,a,b);
+}
+
+/** c = a^2, first weakly reducing a if its bound is too large. */
+static GOLDILOCKS_INLINE void gf_sqr_bd ( gf_s *__restrict__ c, gf a, int *ba ) {
+    if (*ba * *ba > GF_MUL_BOUND) { gf_weak_reduce(a); *ba = 1; }
+    gf_sqr(c,a);
+}
+
 /** Mul by signed int.  Not constant-time WRT the sign of that int. */
 static inline void gf_mulw(gf c, const gf a, int32_t w) {
     if (w>0) {
@@ -12,6 +12,7 @@
 #define __GOLDILOCKS_KECCAK_INTERNAL_H__ 1
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* The internal, non-opaque definition of the goldilocks_sponge struct. */
 typedef union {
@@ -36,4 +37,24 @@ static inline void dokeccak (goldilocks_keccak_sponge_p goldilocks_sponge) {
     goldilocks_sponge->params->position = 0;
 }
 
+/** SP 800-185 left_encode of x; returns the number of bytes written. */
+size_t sp800_185_left_encode (
+    uint8_t out[sizeof(uint64_t)+1],
+    uint64_t x
+);
+
+/**
+ * Start a KMAC sponge: cSHAKE with name "KMAC", followed by the padded key
+ * block.  The caller absorbs the message, then right_encode of the output
+ * length in bits (0 for the XOF variant).
+ */
+void sp800_185_kmac_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *key,
+    size_t key_len,
+    const uint8_t *custom,
+    size_t custom_len
+);
+
 #endif /* __GOLDILOCKS_KECCAK_INTERNAL_H__ */
@@ -0,0 +1,318 @@
+/**
+ * @file pool.c
+ * @copyright
+ *   Copyright (c) 2018 the libgoldilocks contributors.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ *
+ * @brief A work-stealing thread pool for the batch APIs.
+ *
+ * A job of n items is cut into tasks of grain items, and the tasks are dealt
+ * out in contiguous runs, one run per worker.  A worker's run is its deque:
+ * the worker pops tasks from the front, and a worker whose deque is empty
+ * steals the back half of someone else's.  Items which cost more than
+ * others (long messages, early decode failures) so even out without any
+ * shared queue.  The thread which submits a job is worker 0.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <goldilocks/pool.h>
+
+#define POOL_MAX_THREADS 256
+#define POOL_TASKS_PER_THREAD 16
+#define POOL_ALIGN 64
+
+struct pool_job {
+    goldilocks_pool_task_t task;
+    void *ctx;
+    size_t n, grain, scratch_bytes;
+};
+
+struct pool_worker {
+    pthread_mutex_t lock;
+    size_t head, tail;          /* this job's tasks [head, tail) */
+    int ready;                  /* has enough scratch for this job */
+    unsigned long seen;         /* the last generation it has run */
+    void *scratch;
+    size_t scratch_bytes;
+    pthread_t tid;
+    struct goldilocks_pool_s *pool;
+} __attribute__((aligned(POOL_ALIGN)));
+
+struct goldilocks_pool_s {
+    pthread_mutex_t run_lock;   /* one job at a time */
+    pthread_mutex_t lock;       /* guards the fields below */
+    pthread_cond_t wake, idle;
+    const struct pool_job *job;
+    unsigned long generation;
+    unsigned int busy;
+    int stopping;
+    unsigned int nthreads;
+    struct pool_worker *workers;
+};
+
+static int pool_pop (
+    struct pool_worker *w,
+    size_t *task
+) {
+    int ok;
+    pthread_mutex_lock(&w->lock);
+    ok = w->head < w->tail;
+    if (ok) *task = w->head++;
+    pthread_mutex_unlock(&w->lock);
+    return ok;
+}
+
+/* Take a task from worker me's deque, or else steal half of the first
+ * nonempty deque after it.  Returns 0 once every deque is empty.
+ */
+static int pool_take (
+    goldilocks_pool_s *pool,
+    unsigned int me,
+    size_t *task
+) {
+    struct pool_worker *self = &pool->workers[me];
+    unsigned int k;
+
+    if (pool_pop(self, task)) return 1;
+
+    for (k=1; k<pool->nthreads; k++) {
+        struct pool_worker *victim = &pool->workers[(me+k) % pool->nthreads];
+        size_t lo, hi;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->head >= victim->tail) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        hi = victim->tail;
+        lo = hi - (hi - victim->head + 1) / 2;
+        victim->tail = lo;
+        pthread_mutex_unlock(&victim->lock);
+
+        pthread_mutex_lock(&self->lock);
+        self->head = lo+1;
+        self->tail = hi;
+        pthread_mutex_unlock(&self->lock);
+        *task = lo;
+        return 1;
+    }
+    return 0;
+}
+
+static void pool_work (
+    goldilocks_pool_s *pool,
+    const struct pool_job *job,
+    unsigned int me
+) {
+    struct pool_worker *w = &pool->workers[me];
+    void *scratch = job->scratch_bytes ? w->scratch : NULL;
+    size_t task;
+
+    if (!w->ready) return;
+    while (pool_take(pool, me, &task)) {
+        size_t first = task * job->grain, count = job->n - first;
+        if (count > job->grain) count = job->grain;
+        job->task(job->ctx, first, count, scratch);
+    }
+    if (scratch) goldilocks_bzero(scratch, job->scratch_bytes);
+}
+
+static void *pool_thread (void *arg) {
+    struct pool_worker *w = (struct pool_worker *)arg;
+    goldilocks_pool_s *pool = w->pool;
+    unsigned int me = (unsigned int)(w - pool->workers);
+    unsigned long seen = w->seen;
+
+    /* seen was set before the thread started, so a job submitted before
+     * this thread first takes the lock still counts as new */
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        const struct pool_job *job;
+        while (!pool->stopping && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping) break;
+        seen = pool->generation;
+        job = pool->job;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_work(pool, job, me);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->idle);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Make sure w has scratch_bytes of scratch.  Returns 0 if it can't. */
+static int pool_reserve (
+    struct pool_worker *w,
+    size_t scratch_bytes
+) {
+    void *scratch = NULL;
+    if (scratch_bytes <= w->scratch_bytes) return 1;
+    free(w->scratch);
+    w->scratch = NULL;
+    w->scratch_bytes = 0;
+    if (posix_memalign(&scratch, POOL_ALIGN, scratch_bytes)) return 0;
+    w->scratch = scratch;
+    w->scratch_bytes = scratch_bytes;
+    return 1;
+}
+
+goldilocks_pool_s *goldilocks_pool_create (
+    unsigned int nthreads
+) {
+    goldilocks_pool_s *pool;
+    void *workers = NULL;
+    unsigned int i;
+
+    if (nthreads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (nthreads > POOL_MAX_THREADS) nthreads = POOL_MAX_THREADS;
+
+    pool = (goldilocks_pool_s *)calloc(1, sizeof(*pool));
+    if (pool == NULL) return NULL;
+    if (posix_memalign(&workers, POOL_ALIGN, nthreads * sizeof(struct pool_worker))) {
+        free(pool);
+        return NULL;
+    }
+    memset(workers, 0, nthreads * sizeof(struct pool_worker));
+    pool->workers = (struct pool_worker *)workers;
+
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    for (i=0; i<nthreads; i++) {
+        pthread_mutex_init(&pool->workers[i].lock, NULL);
+        pool->workers[i].pool = pool;
+    }
+
+    /* Keep however many threads could be started */
+    pool->nthreads = 1;
+    for (i=1; i<nthreads; i++) {
+        pool->workers[i].seen = pool->generation;
+        if (pthread_create(&pool->workers[i].tid, NULL, pool_thread, &pool->workers[i])) break;
+        pool->nthreads++;
+    }
+    for (i=pool->nthreads; i<nthreads; i++) pthread_mutex_destroy(&pool->workers[i].lock);
+    return pool;
+}
+
+void goldilocks_pool_destroy (
+    goldilocks_pool_s *pool
+) {
+    unsigned int i;
+    if (pool == NULL) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i=1; i<pool->nthreads; i++) pthread_join(pool->workers[i].tid, NULL);
+    for (i=0; i<pool->nthreads; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+        free(pool->workers[i].scratch);
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run_lock);
+    free(pool->workers);
+    free(pool);
+}
+
+unsigned int goldilocks_pool_threads (
+    const goldilocks_pool_s *pool
+) {
+    return pool ? pool->nthreads : 1;
+}
+
+goldilocks_error_t goldilocks_pool_run (
+    goldilocks_pool_s *pool,
+    size_t n,
+    size_t grain,
+    size_t scratch_bytes,
+    goldilocks_pool_task_t task,
+    void *ctx
+) {
+    struct pool_job job;
+    size_t ntasks, per, extra, next;
+    unsigned int i, k, ready = 0;
+
+    if (n == 0) return GOLDILOCKS_SUCCESS;
+
+    if (pool == NULL) {
+        void *scratch = NULL;
+        if (scratch_bytes && posix_memalign(&scratch, POOL_ALIGN, scratch_bytes)) {
+            return GOLDILOCKS_FAILURE;
+        }
+        task(ctx, 0, n, scratch);
+        if (scratch) {
+            goldilocks_bzero(scratch, scratch_bytes);
+            free(scratch);
+        }
+        return GOLDILOCKS_SUCCESS;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+
+    if (grain == 0) grain = n / (pool->nthreads * POOL_TASKS_PER_THREAD);
+    if (grain == 0) grain = 1;
+    ntasks = n / grain + (n % grain != 0);
+
+    for (i=0; i<pool->nthreads; i++) {
+        pool->workers[i].ready = pool_reserve(&pool->workers[i], scratch_bytes);
+        ready += pool->workers[i].ready;
+    }
+    if (ready == 0) {
+        pthread_mutex_unlock(&pool->run_lock);
+        return GOLDILOCKS_FAILURE;
+    }
+
+    /* Deal the tasks out evenly among the workers which are ready */
+    per = ntasks / ready;
+    extra = ntasks % ready;
+    for (i=0, k=0, next=0; i<pool->nthreads; i++) {
+        struct pool_worker *w = &pool->workers[i];
+        w->head = w->tail = next;
+        if (w->ready) {
+            next += per + (k < extra);
+            w->tail = next;
+            k++;
+        }
+    }
+
+    job.task = task;
+    job.ctx = ctx;
+    job.n = n;
+    job.grain = grain;
+    job.scratch_bytes = scratch_bytes;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job = &job;
+    pool->generation++;
+    pool->busy = pool->nthreads - 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_work(pool, &job, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy) pthread_cond_wait(&pool->idle, &pool->lock);
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->run_lock);
+    return GOLDILOCKS_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file precomputed_file.c
+ * @copyright
+ *   Copyright (c) 2018 the libgoldilocks contributors.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ *
+ * @brief Saving precomputed tables to disk, and mapping them back in.
+ *
+ * A table file is a 128-byte header followed by the raw table:
+ *
+ *   offset  size  contents
+ *        0     8  magic, "GLDKPRE1"
+ *        8     4  format version, little-endian (currently 1)
+ *       12     4  header size, little-endian (128)
+ *       16     8  table size, little-endian
+ *       24    32  layout tag: SHAKE256 of the built-in base point table
+ *       56    32  checksum: SHAKE256 of the header (with this field zeroed)
+ *                 followed by the table
+ *       88    40  reserved, zero
+ *
+ * The table itself is stored in the in-memory representation, which
+ * depends on the field implementation.  The layout tag changes whenever
+ * that representation does, so a file written by a different build is
+ * refused rather than misread.  The checksum catches corruption, not
+ * tampering: files should be writable only by whoever is trusted to
+ * produce the tables.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <goldilocks.h>
+#include <goldilocks/shake.h>
+#include "api.h"
+
+#define PRECOMPUTED_FILE_VERSION 1
+#define PRECOMPUTED_HEADER_BYTES 128
+#define PRECOMPUTED_TAG_BYTES 32
+
+static const uint8_t precomputed_magic[8] = { 'G','L','D','K','P','R','E','1' };
+
+enum {
+    OFF_MAGIC = 0,
+    OFF_VERSION = 8,
+    OFF_HEADER_BYTES = 12,
+    OFF_TABLE_BYTES = 16,
+    OFF_LAYOUT = 24,
+    OFF_CHECKSUM = OFF_LAYOUT + PRECOMPUTED_TAG_BYTES
+};
+
+static void put_le(uint8_t *out, uint64_t x, unsigned int bytes) {
+    unsigned int i;
+    for (i=0; i<bytes; i++) out[i] = (uint8_t)(x >> (8*i));
+}
+
+static uint64_t get_le(const uint8_t *in, unsigned int bytes) {
+    uint64_t x = 0;
+    unsigned int i;
+    for (i=0; i<bytes; i++) x |= (uint64_t)in[i] << (8*i);
+    return x;
+}
+
+static uint8_t layout_tag_cached[PRECOMPUTED_TAG_BYTES];
+static pthread_once_t layout_tag_once = PTHREAD_ONCE_INIT;
+
+static void layout_tag_init(void) {
+    goldilocks_shake256_hash(layout_tag_cached, PRECOMPUTED_TAG_BYTES,
+        (const uint8_t *)API_NS(precomputed_base), API_NS(sizeof_precomputed_s));
+}
+
+/* Hashing the base table costs as much as checking a file, so do it once */
+static void layout_tag(uint8_t tag[PRECOMPUTED_TAG_BYTES]) {
+    pthread_once(&layout_tag_once, layout_tag_init);
+    memcpy(tag, layout_tag_cached, PRECOMPUTED_TAG_BYTES);
+}
+
+static void checksum(
+    uint8_t out[PRECOMPUTED_TAG_BYTES],
+    const uint8_t header[PRECOMPUTED_HEADER_BYTES],
+    const uint8_t *table
+) {
+    uint8_t zeros[PRECOMPUTED_TAG_BYTES] = {0};
+    goldilocks_shake256_ctx_p ctx;
+    goldilocks_shake256_init(ctx);
+    goldilocks_shake256_update(ctx, header, OFF_CHECKSUM);
+    goldilocks_shake256_update(ctx, zeros, sizeof(zeros));
+    goldilocks_shake256_update(ctx, header + OFF_CHECKSUM + PRECOMPUTED_TAG_BYTES,
+        PRECOMPUTED_HEADER_BYTES - OFF_CHECKSUM - PRECOMPUTED_TAG_BYTES);
+    goldilocks_shake256_update(ctx, table, API_NS(sizeof_precomputed_s));
+    goldilocks_shake256_final(ctx, out, PRECOMPUTED_TAG_BYTES);
+    goldilocks_shake256_destroy(ctx);
+}
+
+static goldilocks_error_t write_all(int fd, const uint8_t *data, size_t len) {
+    while (len) {
+        ssize_t ret = write(fd, data, len);
+        if (ret <= 0) return GOLDILOCKS_FAILURE;
+        data += ret;
+        len -= ret;
+    }
+    return GOLDILOCKS_SUCCESS;
+}
+
+goldilocks_error_t API_NS(precomputed_save) (
+    const char *filename,
+    const API_NS(precomputed_s) *pre
+) {
+    uint8_t header[PRECOMPUTED_HEADER_BYTES] = {0};
+    char tmpname[4096];
+    goldilocks_error_t ret;
+    int fd;
+
+    memcpy(header + OFF_MAGIC, precomputed_magic, sizeof(precomputed_magic));
+    put_le(header + OFF_VERSION, PRECOMPUTED_FILE_VERSION, 4);
+    put_le(header + OFF_HEADER_BYTES, PRECOMPUTED_HEADER_BYTES, 4);
+    put_le(header + OFF_TABLE_BYTES, API_NS(sizeof_precomputed_s), 8);
+    layout_tag(header + OFF_LAYOUT);
+    checksum(header + OFF_CHECKSUM, header, (const uint8_t *)pre);
+
+    /* Write to a temporary name and rename, so that readers mapping the
+     * file concurrently never see a partial table.
+     */
+    if (snprintf(tmpname, sizeof(tmpname), "%s.tmp.%ld", filename, (long)getpid())
+            >= (int)sizeof(tmpname)) {
+        return GOLDILOCKS_FAILURE;
+    }
+    fd = open(tmpname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return GOLDILOCKS_FAILURE;
+
+    ret = write_all(fd, header, sizeof(header));
+    if (ret == GOLDILOCKS_SUCCESS) {
+        ret = write_all(fd, (const uint8_t *)pre, API_NS(sizeof_precomputed_s));
+    }
+    if (close(fd) != 0) ret = GOLDILOCKS_FAILURE;
+    if (ret == GOLDILOCKS_SUCCESS && rename(tmpname, filename) != 0) ret = GOLDILOCKS_FAILURE;
+    if (ret != GOLDILOCKS_SUCCESS) unlink(tmpname);
+    return ret;
+}
+
+goldilocks_error_t API_NS(precomputed_map) (
+    const API_NS(precomputed_s) **pre,
+    const char *filename
+) {
+    const size_t total = PRECOMPUTED_HEADER_BYTES + API_NS(sizeof_precomputed_s);
+    uint8_t tag[PRECOMPUTED_TAG_BYTES];
+    const uint8_t *map;
+    struct stat st;
+    int fd, ok;
+
+    *pre = NULL;
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) return GOLDILOCKS_FAILURE;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size != total) {
+        close(fd);
+        return GOLDILOCKS_FAILURE;
+    }
+    map = mmap(NULL, total, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return GOLDILOCKS_FAILURE;
+
+    ok = !memcmp(map + OFF_MAGIC, precomputed_magic, sizeof(precomputed_magic))
+        && get_le(map + OFF_VERSION, 4) == PRECOMPUTED_FILE_VERSION
+        && get_le(map + OFF_HEADER_BYTES, 4) == PRECOMPUTED_HEADER_BYTES
+        && get_le(map + OFF_TABLE_BYTES, 8) == API_NS(sizeof_precomputed_s);
+    if (ok) {
+        layout_tag(tag);
+        ok = !memcmp(map + OFF_LAYOUT, tag, sizeof(tag));
+    }
+    if (ok) {
+        checksum(tag, map, map + PRECOMPUTED_HEADER_BYTES);
+        ok = !memcmp(map + OFF_CHECKSUM, tag, sizeof(tag));
+    }
+    if (!ok) {
+        munmap((void *)map, total);
+        return GOLDILOCKS_FAILURE;
+    }
+
+    *pre = (const API_NS(precomputed_s) *)(map + PRECOMPUTED_HEADER_BYTES);
+    return GOLDILOCKS_SUCCESS;
+}
+
+void API_NS(precomputed_unmap) (
+    const API_NS(precomputed_s) *pre
+) {
+    if (pre == NULL) return;
+    munmap((void *)((const uint8_t *)pre - PRECOMPUTED_HEADER_BYTES),
+        PRECOMPUTED_HEADER_BYTES + API_NS(sizeof_precomputed_s));
+}
@@ -15,6 +15,7 @@
 
 #include <goldilocks/point_448.h>
 #include <goldilocks/shake.h>
+#include <goldilocks/pool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -188,6 +189,168 @@ goldilocks_error_t goldilocks_ed448_verify_prehash (
     uint8_t context_len
 ) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2))) GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief A bounded cache of decoded EdDSA public keys, for verifiers which
+ * see the same signers over and over.  Safe to share between threads.
+ */
+typedef struct goldilocks_ed448_verifier_cache_s goldilocks_ed448_verifier_cache_s;
+
+/**
+ * @brief Create a verifier cache.
+ *
+ * @param [in] capacity The maximum number of public keys to remember.  Once
+ * full, the least recently used key is evicted.
+ *
+ * @return The new cache, or NULL if it could not be allocated.
+ */
+goldilocks_ed448_verifier_cache_s *goldilocks_ed448_verifier_cache_create (
+    size_t capacity
+) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Destroy a verifier cache and wipe its contents.
+ *
+ * @param [in] cache The cache to destroy.  May be NULL.
+ */
+void goldilocks_ed448_verifier_cache_destroy (
+    goldilocks_ed448_verifier_cache_s *cache
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Read the lookup counters of a verifier cache.
+ *
+ * @param [in] cache The cache.
+ * @param [out] hits The number of lookups which skipped decoding.
+ * @param [out] misses The number of lookups which had to decode the key.
+ */
+void goldilocks_ed448_verifier_cache_stats (
+    goldilocks_ed448_verifier_cache_s *cache,
+    uint64_t *hits,
+    uint64_t *misses
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief EdDSA signature verification, looking up the decoded public key in
+ * a cache.  Same semantics as goldilocks_ed448_verify.
+ *
+ * Public keys which fail to decode are never cached.
+ *
+ * @param [in] cache The cache.  If NULL, this is goldilocks_ed448_verify.
+ * @param [in] signature The signature.
+ * @param [in] pubkey The public key.
+ * @param [in] message The message to verify.
+ * @param [in] message_len The length of the message.
+ * @param [in] prehashed Nonzero if the message is actually the hash of something you want to verify.
+ * @param [in] context A "context" for this signature of up to 255 bytes.
+ * @param [in] context_len Length of the context.
+ */
+goldilocks_error_t goldilocks_ed448_verify_cached (
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    const uint8_t *message,
+    size_t message_len,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(2,3))) GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief EdDSA signature verification with prehash, looking up the decoded
+ * public key in a cache.  Same semantics as goldilocks_ed448_verify_prehash.
+ *
+ * @param [in] cache The cache.  If NULL, this is goldilocks_ed448_verify_prehash.
+ * @param [in] signature The signature.
+ * @param [in] pubkey The public key.
+ * @param [in] hash The hash of the message.  This object will not be modified by the call.
+ * @param [in] context A "context" for this signature of up to 255 bytes.  Must be the same as what was used for the prehash.
+ * @param [in] context_len Length of the context.
+ */
+goldilocks_error_t goldilocks_ed448_verify_prehash_cached (
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t signature[GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES],
+    const uint8_t pubkey[GOLDILOCKS_EDDSA_448_PUBLIC_BYTES],
+    const goldilocks_ed448_prehash_ctx_p hash,
+    const uint8_t *context,
+    uint8_t context_len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(2,3,4))) GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Derive many EdDSA public keys, splitting the work across a pool.
+ *
+ * @param [out] pubkeys n public keys, back to back.
+ * @param [in] privkeys n private keys, back to back.
+ * @param [in] n The number of keys.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ */
+void goldilocks_ed448_derive_public_key_batch (
+    uint8_t *pubkeys,
+    const uint8_t *privkeys,
+    size_t n,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2))) GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Sign many messages, splitting the work across a pool.  Each
+ * signature is the one goldilocks_ed448_sign would produce.
+ *
+ * @param [out] signatures n signatures, back to back.
+ * @param [in] privkeys n private keys, back to back.
+ * @param [in] pubkeys The n matching public keys, back to back.
+ * @param [in] messages The n messages.
+ * @param [in] message_lens Their lengths.
+ * @param [in] n The number of messages.
+ * @param [in] prehashed Nonzero if the messages are actually hashes of something you want to sign.
+ * @param [in] context A "context" for these signatures of up to 255 bytes.
+ * @param [in] context_len Length of the context.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ */
+void goldilocks_ed448_sign_batch (
+    uint8_t *signatures,
+    const uint8_t *privkeys,
+    const uint8_t *pubkeys,
+    const uint8_t *const messages[],
+    const size_t message_lens[],
+    size_t n,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2,3,4,5))) GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Verify many signatures, splitting the work across a pool.  Each
+ * result is the one goldilocks_ed448_verify_cached would give.
+ *
+ * @param [out] successes Whether each signature verified.
+ * @param [in] cache A verifier cache for the public keys, or NULL.
+ * @param [in] signatures n signatures, back to back.
+ * @param [in] pubkeys n public keys, back to back.
+ * @param [in] messages The n messages.
+ * @param [in] message_lens Their lengths.
+ * @param [in] n The number of signatures.
+ * @param [in] prehashed Nonzero if the messages are actually hashes of something you want to verify.
+ * @param [in] context A "context" for these signatures of up to 255 bytes.
+ * @param [in] context_len Length of the context.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ *
+ * @retval GOLDILOCKS_SUCCESS Every signature verified.
+ * @retval GOLDILOCKS_FAILURE At least one did not; see successes.
+ */
+goldilocks_error_t goldilocks_ed448_verify_batch (
+    goldilocks_bool_t successes[],
+    goldilocks_ed448_verifier_cache_s *cache,
+    const uint8_t *signatures,
+    const uint8_t *pubkeys,
+    const uint8_t *const messages[],
+    const size_t message_lens[],
+    size_t n,
+    uint8_t prehashed,
+    const uint8_t *context,
+    uint8_t context_len,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,3,4,5,6))) GOLDILOCKS_NOINLINE;
+
 /**
  * @brief EdDSA point encoding.  Used internally, exposed externally.
  * Multiplies by GOLDILOCKS_448_EDDSA_ENCODE_RATIO first.
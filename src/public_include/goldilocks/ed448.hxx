@@ -117,20 +117,20 @@ template<class CRTP, Prehashed ph> class Signing;
 template<class CRTP> class Signing<CRTP,PURE>  {
 public:
     /**
-     * Sign a message.
+     * Sign a message into a caller-supplied buffer, without allocating.
+     * @param [out] out The signature.
      * @param [in] message The message to be signed.
      * @param [in] context A context for the signature; must be at most 255 bytes.
-     *
      */
-    inline SecureBuffer sign (
+    inline void sign_into (
+        FixedBuffer<GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES> &out,
         const Block &message,
         const Block &context = NO_CONTEXT()
-    ) const /* throw(LengthException, std::bad_alloc) */ {
+    ) const /* throw(LengthException) */ {
         if (context.size() > 255) {
             throw LengthException();
         }
 
-        SecureBuffer out(CRTP::SIG_BYTES);
         goldilocks_ed448_sign (
             out.data(),
             ((const CRTP*)this)->priv_.data(),
@@ -141,6 +141,21 @@ public:
             context.data(),
             context.size()
         );
+    }
+
+    /**
+     * Sign a message.
+     * @param [in] message The message to be signed.
+     * @param [in] context A context for the signature; must be at most 255 bytes.
+     *
+     */
+    inline SecureBuffer sign (
+        const Block &message,
+        const Block &context = NO_CONTEXT()
+    ) const /* throw(LengthException, std::bad_alloc) */ {
+        SecureBuffer out(CRTP::SIG_BYTES);
+        FixedBuffer<GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES> fout(out);
+        sign_into(fout, message, context);
         return out;
     }
 };
@@ -148,9 +163,11 @@ public:
 /** Signing (i.e. private) key class, prehashed version */
 template<class CRTP> class Signing<CRTP,PREHASHED> {
 public:
-    /** Sign a prehash context, and reset the context */
-    inline SecureBuffer sign_prehashed ( const Prehash &ph ) const /*throw(std::bad_alloc)*/ {
-        SecureBuffer out(CRTP::SIG_BYTES);
+    /** Sign a prehash context into a caller-supplied buffer, without allocating */
+    inline void sign_prehashed_into (
+        FixedBuffer<GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES> &out,
+        const Prehash &ph
+    ) const GOLDILOCKS_NOEXCEPT {
         goldilocks_ed448_sign_prehash (
             out.data(),
             ((const CRTP*)this)->priv_.data(),
@@ -159,6 +176,13 @@ public:
             ph.context_.data(),
             ph.context_.size()
         );
+    }
+
+    /** Sign a prehash context, and reset the context */
+    inline SecureBuffer sign_prehashed ( const Prehash &ph ) const /*throw(std::bad_alloc)*/ {
+        SecureBuffer out(CRTP::SIG_BYTES);
+        FixedBuffer<GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES> fout(out);
+        sign_prehashed_into(fout, ph);
         return out;
     }
 
@@ -248,6 +272,11 @@ public:
         return out;
     }
 
+    /** Convert to X format into a caller-supplied buffer, without allocating */
+    inline void convert_to_x(FixedBuffer<GOLDILOCKS_X448_PRIVATE_BYTES> &out) const GOLDILOCKS_NOEXCEPT {
+        goldilocks_ed448_convert_private_key_to_x448(out.data(), priv_.data());
+    }
+
     /** Return the corresponding public key */
     inline PublicKey pub() const GOLDILOCKS_NOEXCEPT {
         PublicKey pub(*this);
@@ -419,6 +448,11 @@ public:
         goldilocks_ed448_convert_public_key_to_x448(out.data(), pub_.data());
         return out;
     }
+
+    /** Convert to X format into a caller-supplied buffer, without allocating */
+    inline void convert_to_x(FixedBuffer<GOLDILOCKS_X448_PUBLIC_BYTES> &out) const GOLDILOCKS_NOEXCEPT {
+        goldilocks_ed448_convert_public_key_to_x448(out.data(), pub_.data());
+    }
 }; /* class PublicKey */
 
 }; /* template<> struct EdDSA<Ed448Goldilocks> */
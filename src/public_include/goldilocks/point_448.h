@@ -19,6 +19,12 @@
 extern "C" {
 #endif
 
+/** @cond internal */
+/* Only passed by pointer here; see spongerng.h and pool.h */
+struct goldilocks_keccak_prng_s;
+struct goldilocks_pool_s;
+/** @endcond */
+
 /** @cond internal */
 #define GOLDILOCKS_448_SCALAR_LIMBS ((446-1)/GOLDILOCKS_WORD_BITS+1)
 /** @endcond */
@@ -53,6 +59,9 @@ typedef struct gf_448_s {
 /** The cofactor the curve would have, if we hadn't removed it */
 #define GOLDILOCKS_448_REMOVED_COFACTOR 4
 
+/** Number of bins in the retry histogram of goldilocks_448_point_steg_encode_batch */
+#define GOLDILOCKS_448_STEG_HISTOGRAM_BINS 16
+
 /** X448 encoding ratio. */
 #define GOLDILOCKS_X448_ENCODE_RATIO 2
 
@@ -69,6 +78,13 @@ typedef struct goldilocks_448_point_s {
     /** @endcond */
 } goldilocks_448_point_s, goldilocks_448_point_p[1];
 
+/** A point prepared for repeated addition to other points. */
+typedef struct goldilocks_448_prepared_point_s {
+    /** @cond internal */
+    gf_448_p a,b,c,z; /* Projective Niels coordinates: y-x, y+x, 2dt, 2z */
+    /** @endcond */
+} goldilocks_448_prepared_point_s, goldilocks_448_prepared_point_p[1];
+
 /** Precomputed table based on a point.  Can be trivial implementation. */
 struct goldilocks_448_precomputed_s;
 
@@ -129,6 +145,23 @@ void goldilocks_448_scalar_decode_long (
     size_t ser_len
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Sample uniformly random scalars.
+ *
+ * Equivalent to reducing GOLDILOCKS_448_SCALAR_BYTES+16 random bytes for
+ * each scalar, but squeezes the RNG once per block of scalars instead of
+ * once per scalar.
+ *
+ * @param [in] rng The RNG to sample from.
+ * @param [out] out The random scalars.
+ * @param [in] n The number of scalars.
+ */
+void goldilocks_448_scalar_random_batch (
+    struct goldilocks_keccak_prng_s *rng,
+    goldilocks_448_scalar_p out[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Serialize a scalar to wire format.
  *
@@ -209,6 +242,53 @@ goldilocks_error_t goldilocks_448_scalar_invert (
     const goldilocks_448_scalar_p a
 ) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Invert many scalars with Montgomery's trick, at the cost of one
+ * inversion and five multiplications per scalar.
+ *
+ * Zero inputs are inverted to zero.  The input and output must not overlap.
+ *
+ * @param [out] out The inverses.
+ * @param [in] in The scalars to invert.
+ * @param [in] n The number of scalars.
+ *
+ * @retval GOLDILOCKS_SUCCESS All of the inputs were nonzero.
+ * @retval GOLDILOCKS_FAILURE At least one input was zero.
+ */
+goldilocks_error_t goldilocks_448_scalar_invert_batch (
+    goldilocks_448_scalar_p out[],
+    const goldilocks_448_scalar_p in[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Multiply arrays of scalars elementwise.  The arrays may alias.
+ * @param [out] out out[i] = a[i]*b[i].
+ * @param [in] a Some scalars.
+ * @param [in] b Some more scalars.
+ * @param [in] n The number of scalars.
+ */
+void goldilocks_448_scalar_mul_batch (
+    goldilocks_448_scalar_p out[],
+    const goldilocks_448_scalar_p a[],
+    const goldilocks_448_scalar_p b[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Add arrays of scalars elementwise.  The arrays may alias.
+ * @param [out] out out[i] = a[i]+b[i].
+ * @param [in] a Some scalars.
+ * @param [in] b Some more scalars.
+ * @param [in] n The number of scalars.
+ */
+void goldilocks_448_scalar_add_batch (
+    goldilocks_448_scalar_p out[],
+    const goldilocks_448_scalar_p a[],
+    const goldilocks_448_scalar_p b[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Copy a scalar.  The scalars may use the same memory, in which
  * case this function does nothing.
@@ -263,6 +343,33 @@ goldilocks_error_t goldilocks_448_point_decode (
     goldilocks_bool_t allow_identity
 ) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Decode and validate many points at once.
+ *
+ * A convenience loop which calls goldilocks_448_point_decode on each
+ * encoding in turn, reporting each point's success separately.  Each
+ * decode needs its own square root, so no work is shared between the
+ * points.  Decoding also checks
+ * that each point is on the curve and in the prime-order group, so no
+ * further validation is needed.
+ *
+ * @param [out] out The decoded points.  Those which failed are set to the identity.
+ * @param [out] successes Whether each point decoded.
+ * @param [in] ser n encodings of GOLDILOCKS_448_SER_BYTES, back to back.
+ * @param [in] n The number of points.
+ * @param [in] allow_identity Allow the identity to be decoded.
+ *
+ * @retval GOLDILOCKS_SUCCESS Every point decoded.
+ * @retval GOLDILOCKS_FAILURE At least one point failed; see successes.
+ */
+goldilocks_error_t goldilocks_448_point_decode_and_validate_batch (
+    goldilocks_448_point_p out[],
+    goldilocks_bool_t successes[],
+    const uint8_t *ser,
+    size_t n,
+    goldilocks_bool_t allow_identity
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Copy a point.  The input and output may alias,
  * in which case this function does nothing.
@@ -306,6 +413,80 @@ void goldilocks_448_point_add (
     const goldilocks_448_point_p b
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
 
+/**
+ * @brief Prepare a point for repeated addition to other points.
+ *
+ * @param [out] out The prepared point.
+ * @param [in] p The point to prepare.
+ */
+void goldilocks_448_point_prepare (
+    goldilocks_448_prepared_point_p out,
+    const goldilocks_448_point_p p
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Add a prepared point to a point.  This is cheaper than
+ * goldilocks_448_point_add, because half the work was done by
+ * goldilocks_448_point_prepare.
+ *
+ * @param [out] sum The sum a+b.
+ * @param [in] a A point.
+ * @param [in] b A prepared point.
+ */
+void goldilocks_448_point_add_prepared (
+    goldilocks_448_point_p sum,
+    const goldilocks_448_point_p a,
+    const goldilocks_448_prepared_point_p b
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Subtract a prepared point from a point.
+ *
+ * @param [out] diff The difference a-b.
+ * @param [in] a A point.
+ * @param [in] b A prepared point.
+ */
+void goldilocks_448_point_sub_prepared (
+    goldilocks_448_point_p diff,
+    const goldilocks_448_point_p a,
+    const goldilocks_448_prepared_point_p b
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Add many points together.
+ *
+ * Faster than adding the points one at a time with goldilocks_448_point_add
+ * when the four-lane field arithmetic is available, because the running sum
+ * stays in that form between additions.
+ *
+ * @param [out] sum The sum of the points, or the identity if n is 0.
+ * @param [in] pts The points to add.
+ * @param [in] n The number of points.
+ */
+void goldilocks_448_point_sum (
+    goldilocks_448_point_p sum,
+    const goldilocks_448_point_p pts[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Scale many points to Z=1, sharing one field inversion per block of them.
+ *
+ * The points are unchanged as group elements.  None of the library's own
+ * operations, prepared points included, run faster on normalized points, since
+ * they all carry a full Z; this is for callers which want the affine
+ * coordinates themselves.  The input and output may alias.
+ *
+ * @param [out] out The normalized points.
+ * @param [in] in The points to normalize.
+ * @param [in] n The number of points.
+ */
+void goldilocks_448_points_normalize_batch (
+    goldilocks_448_point_p out[],
+    const goldilocks_448_point_p in[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Double a point.  Equivalent to
  * goldilocks_448_point_add(two_a,a,a), but potentially faster.
@@ -447,6 +628,45 @@ void goldilocks_x448_derive_public_key (
     const uint8_t scalar[GOLDILOCKS_X448_PRIVATE_BYTES]
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Compute many RFC 7748 shared secrets, splitting the work across a
+ * pool.  Each is the one goldilocks_x448 would compute.
+ *
+ * @param [out] shared n shared secrets, back to back.
+ * @param [out] successes Whether each scalarmul succeeded.
+ * @param [in] bases n public keys, back to back.
+ * @param [in] scalars n private scalars, back to back.
+ * @param [in] n The number of scalarmuls.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ *
+ * @retval GOLDILOCKS_SUCCESS Every scalarmul succeeded.
+ * @retval GOLDILOCKS_FAILURE At least one base point was in a small
+ * subgroup; see successes.
+ */
+goldilocks_error_t goldilocks_x448_batch (
+    uint8_t *shared,
+    goldilocks_bool_t successes[],
+    const uint8_t *bases,
+    const uint8_t *scalars,
+    size_t n,
+    struct goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2,3,4))) GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Derive many RFC 7748 public keys, splitting the work across a pool.
+ *
+ * @param [out] out n public keys, back to back.
+ * @param [in] scalars n private scalars, back to back.
+ * @param [in] n The number of keys.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ */
+void goldilocks_x448_derive_public_key_batch (
+    uint8_t *out,
+    const uint8_t *scalars,
+    size_t n,
+    struct goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2))) GOLDILOCKS_NOINLINE;
+
 /* FUTURE: uint8_t goldilocks_448_encode_like_curve448) */
 
 /**
@@ -463,6 +683,22 @@ void goldilocks_448_precompute (
     const goldilocks_448_point_p b
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Precompute tables for several points at once.  This gives the
+ * same tables as calling goldilocks_448_precompute on each point, but
+ * shares the field inversion that normalizes them between up to four
+ * tables, which makes each table somewhat cheaper to build.
+ *
+ * @param [out] tables The precomputed tables, one per point.
+ * @param [in] bases The points.
+ * @param [in] n The number of points.
+ */
+void goldilocks_448_precompute_batch (
+    goldilocks_448_precomputed_s *const tables[],
+    const goldilocks_448_point_p bases[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Multiply a precomputed base point by a scalar:
  * scaled = scalar*base.
@@ -480,6 +716,53 @@ void goldilocks_448_precomputed_scalarmul (
     const goldilocks_448_scalar_p scalar
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Save a precomputed table to a file.
+ *
+ * The file has a versioned, checksummed header followed by the table in
+ * its in-memory form, and can be mapped back in with
+ * goldilocks_448_precomputed_map.  It is written under a temporary name
+ * and renamed into place, so concurrent readers never see a partial file.
+ *
+ * @param [in] filename Where to save the table.
+ * @param [in] pre The table.
+ *
+ * @retval GOLDILOCKS_SUCCESS The table was saved.
+ * @retval GOLDILOCKS_FAILURE The file couldn't be written.
+ */
+goldilocks_error_t goldilocks_448_precomputed_save (
+    const char *filename,
+    const goldilocks_448_precomputed_s *pre
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Map a table saved by goldilocks_448_precomputed_save read-only
+ * into memory.  Processes which map the same file share its pages.
+ *
+ * The checksum only detects corruption; anyone who can write the file
+ * controls the results of scalar multiplications with it.
+ *
+ * @param [out] pre The mapped table, or NULL on failure.  Release it with
+ * goldilocks_448_precomputed_unmap.
+ * @param [in] filename The file to map.
+ *
+ * @retval GOLDILOCKS_SUCCESS The table was mapped.
+ * @retval GOLDILOCKS_FAILURE The file was missing, truncated, corrupt, or
+ * written by a build with a different table layout.
+ */
+goldilocks_error_t goldilocks_448_precomputed_map (
+    const goldilocks_448_precomputed_s **pre,
+    const char *filename
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Unmap a table mapped by goldilocks_448_precomputed_map.
+ * @param [in] pre The table.  May be NULL.
+ */
+void goldilocks_448_precomputed_unmap (
+    const goldilocks_448_precomputed_s *pre
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Multiply two base points by two scalars:
  * scaled = scalar1*base1 + scalar2*base2.
@@ -663,6 +946,24 @@ void goldilocks_448_point_from_hash_uniform (
     const unsigned char hashed_data[2*GOLDILOCKS_448_HASH_BYTES]
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
 
+/**
+ * @brief Sample uniformly random points.
+ *
+ * Equivalent to goldilocks_448_point_from_hash_uniform on 2*GOLDILOCKS_448_HASH_BYTES
+ * random bytes for each point, but squeezes the RNG once per block of points
+ * instead of once per point.  The map itself still runs per point, since
+ * each of its square roots depends on that point alone.
+ *
+ * @param [in] rng The RNG to sample from.
+ * @param [out] out The random points.
+ * @param [in] n The number of points.
+ */
+void goldilocks_448_point_random_batch (
+    struct goldilocks_keccak_prng_s *rng,
+    goldilocks_448_point_p out[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
 /**
  * @brief Inverse of elligator-like hash to curve.
  *
@@ -723,11 +1024,61 @@ goldilocks_448_invert_elligator_uniform (
     uint32_t which
 ) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE GOLDILOCKS_WARN_UNUSED;
 
+/**
+ * @brief Inverse of elligator-like hash to curve, on many points at once.
+ *
+ * A convenience loop which calls goldilocks_448_invert_elligator_uniform on
+ * each point in turn, recording each result in successes.  Each inverse
+ * needs its own square root, so no work is shared between the points.
+ *
+ * @param [inout] partial_hashes n buffers of 2*GOLDILOCKS_448_HASH_BYTES, back to back.
+ * The upper half of each is an input, and the lower half is written.
+ * @param [out] successes Whether each inverse succeeded.
+ * @param [in] pts The points to encode.
+ * @param [in] hints The "which" value for each point.
+ * @param [in] n The number of points.
+ */
+void goldilocks_448_invert_elligator_uniform_batch (
+    unsigned char *partial_hashes,
+    goldilocks_bool_t successes[],
+    const goldilocks_448_point_p pts[],
+    const uint32_t hints[],
+    size_t n
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Encode many points as uniformly random strings.
+ *
+ * Each point gets 2*GOLDILOCKS_448_HASH_BYTES of output which
+ * goldilocks_448_point_from_hash_uniform maps back to it.  Points are
+ * retried with fresh randomness until their inverse succeeds, a round at a
+ * time; each round squeezes the RNG once for all the points still left.
+ *
+ * @param [out] out n encodings of 2*GOLDILOCKS_448_HASH_BYTES, back to back.
+ * @param [in] pts The points to encode.
+ * @param [in] n The number of points.
+ * @param [in] rng The RNG for the random halves and "which" values.
+ * @param [inout] histogram If non-NULL, histogram[i] is incremented for each
+ * point which needed i+1 attempts; the last bin also counts longer runs.
+ */
+void goldilocks_448_point_steg_encode_batch (
+    unsigned char *out,
+    const goldilocks_448_point_p pts[],
+    size_t n,
+    struct goldilocks_keccak_prng_s *rng,
+    uint64_t histogram[GOLDILOCKS_448_STEG_HISTOGRAM_BINS]
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
 /** Securely erase a scalar. */
 void goldilocks_448_scalar_destroy (
     goldilocks_448_scalar_p scalar
 ) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
 
+/** Securely erase a prepared point by overwriting it with zeros. */
+void goldilocks_448_prepared_point_destroy (
+    goldilocks_448_prepared_point_p pt
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
 /** Securely erase a point by overwriting it with zeros.
  * @warning This causes the point object to become invalid.
  */
@@ -33,6 +33,7 @@
 #include <goldilocks/point_448.h>
 #include <goldilocks/ed448.h>
 #include <goldilocks/secure_buffer.hxx>
+#include <goldilocks/spongerng.h>
 #include <string>
 #include <sys/types.h>
 #include <limits.h>
@@ -66,6 +67,7 @@ static const int FIELD_MODULUS_TYPE = 3;
 
 /** @cond internal */
 class Point;
+class PreparedPoint;
 class Precomputed;
 /** @endcond */
 
@@ -107,6 +109,16 @@ public:
         *this = sb;
     }
 
+    /** Fill an array with random scalars, reading the RNG once per block of them. */
+    static inline void random_batch(Rng &rng, Scalar *out, size_t n) /*throw(std::bad_alloc)*/ {
+        const size_t BATCH = 32, BYTES = SER_BYTES + 16;
+        SecureBuffer b(BATCH*BYTES);
+        for (size_t i=0; i<n; i++) {
+            if (i % BATCH == 0) rng.read(Buffer(b.data(), ((n-i < BATCH) ? n-i : BATCH) * BYTES));
+            goldilocks_448_scalar_decode_long(out[i].s, &b[(i % BATCH) * BYTES], BYTES);
+        }
+    }
+
     /** Construct from goldilocks_scalar_p object. */
     inline Scalar(const Wrapped &t = goldilocks_448_scalar_zero) GOLDILOCKS_NOEXCEPT { goldilocks_448_scalar_copy(s,t); }
 
@@ -124,6 +136,15 @@ public:
         goldilocks_448_scalar_encode(buffer, s);
     }
 
+#if __cplusplus >= 201103L
+    /** Serialize to a stack buffer, without allocating. */
+    inline FixedArrayBuffer<SER_BYTES> serialize_fixed() const GOLDILOCKS_NOEXCEPT {
+        FixedArrayBuffer<SER_BYTES> out((NOINIT()));
+        goldilocks_448_scalar_encode(out.data(), s);
+        return out;
+    }
+#endif
+
     /** Assignment. */
     inline Scalar& operator=(const Scalar &x) GOLDILOCKS_NOEXCEPT { goldilocks_448_scalar_copy(s,x.s); return *this; }
 
@@ -202,6 +223,28 @@ public:
         return goldilocks_448_scalar_invert(r.s,s);
     }
 
+    /** Invert an array of scalars, sharing one inversion per block of them.
+     * Zeros are inverted to zero.
+     * @return GOLDILOCKS_FAILURE if any input was 0.
+     */
+    static inline goldilocks_error_t GOLDILOCKS_WARN_UNUSED
+    invert_batch(Scalar *out, const Scalar *in, size_t n) GOLDILOCKS_NOEXCEPT {
+        const size_t BATCH = 64;
+        goldilocks_448_scalar_p tin[BATCH], tout[BATCH];
+        goldilocks_error_t ret = GOLDILOCKS_SUCCESS;
+        for (size_t i=0; i<n; i+=BATCH) {
+            size_t todo = (n-i < BATCH) ? n-i : BATCH;
+            for (size_t j=0; j<todo; j++) goldilocks_448_scalar_copy(tin[j], in[i+j].s);
+            if (!goldilocks_successful(goldilocks_448_scalar_invert_batch(tout, tin, todo))) {
+                ret = GOLDILOCKS_FAILURE;
+            }
+            for (size_t j=0; j<todo; j++) goldilocks_448_scalar_copy(out[i+j].s, tout[j]);
+        }
+        goldilocks_bzero(tin, sizeof(tin));
+        goldilocks_bzero(tout, sizeof(tout));
+        return ret;
+    }
+
     /** Return this/q. @throw CryptoException if q == 0. */
     inline Scalar operator/ (const Scalar &q) const /*throw(CryptoException)*/ { return *this * q.inverse(); }
 
@@ -273,6 +316,9 @@ public:
      */
     static const size_t STEG_BYTES = HASH_BYTES * 2;
 
+    /** Number of bins in the retry histogram of steg_encode_batch. */
+    static const size_t STEG_HISTOGRAM_BINS = GOLDILOCKS_448_STEG_HISTOGRAM_BINS;
+
     /** Number of bits in invert_elligator which are actually used. */
     static const unsigned int INVERT_ELLIGATOR_WHICH_BITS = GOLDILOCKS_448_INVERT_ELLIGATOR_WHICH_BITS;
 
@@ -282,6 +328,18 @@ public:
     /** @cond internal */
     /** Don't initialize. */
     inline Point(const NOINIT &) GOLDILOCKS_NOEXCEPT {}
+
+    /** View an array of Points as the array of Wrapped that the C batch functions take. */
+    static inline const Wrapped *wrapped_array(const Point *pts) GOLDILOCKS_NOEXCEPT {
+        typedef char point_is_just_wrapped[(sizeof(Point) == sizeof(Wrapped)) ? 1 : -1];
+        (void)sizeof(point_is_just_wrapped);
+        return reinterpret_cast<const Wrapped *>(pts);
+    }
+
+    /** View an array of Points as the array of Wrapped that the C batch functions take. */
+    static inline Wrapped *wrapped_array(Point *pts) GOLDILOCKS_NOEXCEPT {
+        return const_cast<Wrapped *>(wrapped_array(const_cast<const Point *>(pts)));
+    }
     /** @endcond */
 
     /** Constructor sets to identity by default. */
@@ -307,6 +365,16 @@ public:
         }
     }
 
+    /** Fill an array with uniformly random points, reading the RNG once per block of them. */
+    static inline void random_batch(Rng &rng, Point *out, size_t n) /*throw(std::bad_alloc)*/ {
+        const size_t BATCH = 32, BYTES = 2*HASH_BYTES;
+        SecureBuffer b(BATCH*BYTES);
+        for (size_t i=0; i<n; i++) {
+            if (i % BATCH == 0) rng.read(Buffer(b.data(), ((n-i < BATCH) ? n-i : BATCH) * BYTES));
+            goldilocks_448_point_from_hash_uniform(out[i].p, &b[(i % BATCH) * BYTES]);
+        }
+    }
+
    /**
     * Initialize from a fixed-length byte string.
     * The all-zero string maps to the identity.
@@ -335,6 +403,34 @@ public:
         return goldilocks_448_point_decode(p,buffer.data(),allow_identity ? GOLDILOCKS_TRUE : GOLDILOCKS_FALSE);
     }
 
+    /**
+     * Decode and validate a run of back-to-back encodings, one at a time.
+     * If successes is non-NULL, it is filled in for each point.  Points which fail
+     * are set to the identity.
+     * @retval GOLDILOCKS_SUCCESS every point was decoded.
+     * @retval GOLDILOCKS_FAILURE at least one point failed.
+     * @throw LengthException if the data isn't a whole number of encodings.
+     */
+    static inline goldilocks_error_t GOLDILOCKS_WARN_UNUSED decode_batch (
+        Point *out, const Block &buffer, bool allow_identity=true, bool *successes=NULL
+    ) /*throw(LengthException)*/ {
+        const size_t BATCH = 32;
+        if (buffer.size() % SER_BYTES) throw LengthException();
+        goldilocks_bool_t succ[BATCH];
+        goldilocks_error_t ret = GOLDILOCKS_SUCCESS;
+        for (size_t i=0, n=buffer.size()/SER_BYTES; i<n; i+=BATCH) {
+            size_t todo = (n-i < BATCH) ? n-i : BATCH;
+            if (!goldilocks_successful(goldilocks_448_point_decode_and_validate_batch(
+                wrapped_array(out+i), succ, buffer.data()+i*SER_BYTES, todo,
+                allow_identity ? GOLDILOCKS_TRUE : GOLDILOCKS_FALSE
+            ))) ret = GOLDILOCKS_FAILURE;
+            if (successes) {
+                for (size_t j=0; j<todo; j++) successes[i+j] = !!succ[j];
+            }
+        }
+        return ret;
+    }
+
     /**
      * Initialize from C++ fixed-length byte string, like EdDSA.
      * The all-zero string maps to the identity.
@@ -404,13 +500,13 @@ public:
      */
     inline void set_to_hash( const Block &s ) GOLDILOCKS_NOEXCEPT {
         if (s.size() < HASH_BYTES) {
-            SecureBuffer b(HASH_BYTES);
+            FixedArrayBuffer<HASH_BYTES> b;
             memcpy(b.data(), s.data(), s.size());
             goldilocks_448_point_from_hash_nonuniform(p,b.data());
         } else if (s.size() == HASH_BYTES) {
             goldilocks_448_point_from_hash_nonuniform(p,s.data());
         } else if (s.size() < 2*HASH_BYTES) {
-            SecureBuffer b(2*HASH_BYTES);
+            FixedArrayBuffer<2*HASH_BYTES> b;
             memcpy(b.data(), s.data(), s.size());
             goldilocks_448_point_from_hash_uniform(p,b.data());
         } else {
@@ -433,6 +529,15 @@ public:
         goldilocks_448_point_encode(buffer, p);
     }
 
+#if __cplusplus >= 201103L
+    /** Serialize to a stack buffer, without allocating. */
+    inline FixedArrayBuffer<SER_BYTES> serialize_fixed() const GOLDILOCKS_NOEXCEPT {
+        FixedArrayBuffer<SER_BYTES> out((NOINIT()));
+        goldilocks_448_point_encode(out.data(), p);
+        return out;
+    }
+#endif
+
     /** Point add. */
     inline Point operator+ (const Point &q) const GOLDILOCKS_NOEXCEPT { Point r((NOINIT())); goldilocks_448_point_add(r.p,p,q.p); return r; }
 
@@ -568,6 +673,37 @@ public:
         return out;
     }
 
+    /**
+     * Steganographically encode many points, as steg_encode does with the default size.
+     * Returns n encodings of STEG_BYTES, back to back.  The retries are drawn from a
+     * sponge seeded by rng.  If histogram is non-NULL, histogram[i] is incremented for
+     * each point which needed i+1 attempts, with the last of its STEG_HISTOGRAM_BINS
+     * also counting longer runs.
+     */
+    static inline SecureBuffer steg_encode_batch(
+        Rng &rng, const Point *pts, size_t n, uint64_t *histogram = NULL
+    ) /*throw(std::bad_alloc)*/ {
+        SecureBuffer out(n*STEG_BYTES);
+        FixedArrayBuffer<64> seed(rng);
+        goldilocks_keccak_prng_p sponge;
+        goldilocks_spongerng_init_from_buffer(sponge, seed.data(), seed.size(), 1);
+        goldilocks_448_point_steg_encode_batch(out.data(), wrapped_array(pts), n, sponge, histogram);
+        goldilocks_spongerng_destroy(sponge);
+        return out;
+    }
+
+    /** Add up an array of points. */
+    static inline Point sum(const Point *pts, size_t n) GOLDILOCKS_NOEXCEPT {
+        Point ret((NOINIT()));
+        goldilocks_448_point_sum(ret.p, wrapped_array(pts), n);
+        return ret;
+    }
+
+    /** Scale an array of points to Z=1 in place, sharing the inversions. */
+    static inline void normalize_batch(Point *pts, size_t n) GOLDILOCKS_NOEXCEPT {
+        goldilocks_448_points_normalize_batch(wrapped_array(pts), wrapped_array(pts), n);
+    }
+
     /** Return the base point of the curve. */
     static inline const Point base() GOLDILOCKS_NOEXCEPT { return Point(goldilocks_448_point_base); }
 
@@ -575,6 +711,59 @@ public:
     static inline const Point identity() GOLDILOCKS_NOEXCEPT { return Point(goldilocks_448_point_identity); }
 };
 
+/**
+ * A point prepared for repeated addition to other points.
+ * Adding one is cheaper than adding a Point, because half the work is done once, here.
+ */
+class PreparedPoint {
+public:
+    /** wrapped C type */
+    typedef goldilocks_448_prepared_point_p Wrapped;
+
+    /** @cond internal */
+    Wrapped p;
+    /** @endcond */
+
+    /** Prepare a point. */
+    inline explicit PreparedPoint(const Point &q = Point::identity()) GOLDILOCKS_NOEXCEPT {
+        goldilocks_448_point_prepare(p,q.p);
+    }
+
+    /** Copy constructor. */
+    inline PreparedPoint(const PreparedPoint &q) GOLDILOCKS_NOEXCEPT { *this = q; }
+
+    /** Assignment. */
+    inline PreparedPoint &operator=(const PreparedPoint &q) GOLDILOCKS_NOEXCEPT { *p = *q.p; return *this; }
+
+    /** Assign from a point. */
+    inline PreparedPoint &operator=(const Point &q) GOLDILOCKS_NOEXCEPT {
+        goldilocks_448_point_prepare(p,q.p); return *this;
+    }
+
+    /** Destructor securely zeorizes the prepared point. */
+    inline ~PreparedPoint() GOLDILOCKS_NOEXCEPT { goldilocks_448_prepared_point_destroy(p); }
+
+    /** Add a prepared point to a point. */
+    friend inline Point &operator+=(Point &a, const PreparedPoint &b) GOLDILOCKS_NOEXCEPT {
+        goldilocks_448_point_add_prepared(a.p,a.p,b.p); return a;
+    }
+
+    /** Subtract a prepared point from a point. */
+    friend inline Point &operator-=(Point &a, const PreparedPoint &b) GOLDILOCKS_NOEXCEPT {
+        goldilocks_448_point_sub_prepared(a.p,a.p,b.p); return a;
+    }
+
+    /** Add a prepared point to a point. */
+    friend inline Point operator+(const Point &a, const PreparedPoint &b) GOLDILOCKS_NOEXCEPT {
+        Point r((NOINIT())); goldilocks_448_point_add_prepared(r.p,a.p,b.p); return r;
+    }
+
+    /** Subtract a prepared point from a point. */
+    friend inline Point operator-(const Point &a, const PreparedPoint &b) GOLDILOCKS_NOEXCEPT {
+        Point r((NOINIT())); goldilocks_448_point_sub_prepared(r.p,a.p,b.p); return r;
+    }
+};
+
 /**
  * Precomputed table of points.
  * Minor difficulties arise here because the goldilocks API doesn't expose, as a constant, how big such an object is.
@@ -651,6 +840,26 @@ public:
     inline explicit Precomputed(const Point &it) /*throw(std::bad_alloc)*/
         : OwnedOrUnowned<Precomputed,Precomputed_U>() { *this = it; }
 
+    /**
+     * Initialize out[i] from in[i], sharing work between the tables.
+     * Must allocate memory, and may throw.
+     */
+    static inline void precompute_batch(Precomputed *out, const Point *in, size_t n) /*throw(std::bad_alloc)*/ {
+        const size_t BATCH = 16;
+        goldilocks_448_precomputed_s *tables[BATCH];
+        goldilocks_448_point_p bases[BATCH];
+        for (size_t i=0; i<n; i+=BATCH) {
+            size_t todo = (n-i < BATCH) ? n-i : BATCH;
+            for (size_t j=0; j<todo; j++) {
+                out[i+j].alloc();
+                tables[j] = out[i+j].ours.mine;
+                goldilocks_448_point_copy(bases[j], in[i+j].p);
+            }
+            goldilocks_448_precompute_batch(tables, bases, todo);
+        }
+        goldilocks_bzero(bases, sizeof(bases));
+    }
+
     /** Fixed base scalarmul. */
     inline Point operator* (const Scalar &s) const GOLDILOCKS_NOEXCEPT { Point r; goldilocks_448_precomputed_scalarmul(r.p,get(),s.s); return r; }
 
@@ -660,6 +869,15 @@ public:
     /** Return the table for the base point. */
     static inline const Precomputed base() GOLDILOCKS_NOEXCEPT { return Precomputed(); }
 
+    /** Save the table to a file which MappedPrecomputed can load.
+     * @throw CryptoException if the file couldn't be written.
+     */
+    inline void save(const char *filename) const /*throw(CryptoException)*/ {
+        if (GOLDILOCKS_SUCCESS != goldilocks_448_precomputed_save(filename, get())) {
+            throw CryptoException();
+        }
+    }
+
 public:
     /** @cond internal */
     friend class OwnedOrUnowned<Precomputed,Precomputed_U>;
@@ -669,6 +887,37 @@ public:
     /** @endcond */
 };
 
+/**
+ * A precomputed table mapped read-only from a file written by
+ * Precomputed::save.  Processes which map the same file share one copy.
+ */
+class MappedPrecomputed {
+private:
+    /** @cond internal */
+    const Precomputed_U *table_;
+    MappedPrecomputed(const MappedPrecomputed &);
+    MappedPrecomputed &operator=(const MappedPrecomputed &);
+    /** @endcond */
+public:
+    /** Map a table.
+     * @throw CryptoException if the file is missing, corrupt, or from an incompatible build.
+     */
+    inline explicit MappedPrecomputed(const char *filename) /*throw(CryptoException)*/ {
+        if (GOLDILOCKS_SUCCESS != goldilocks_448_precomputed_map(&table_, filename)) {
+            throw CryptoException();
+        }
+    }
+
+    /** Unmap the table. */
+    inline ~MappedPrecomputed() GOLDILOCKS_NOEXCEPT { goldilocks_448_precomputed_unmap(table_); }
+
+    /** A Precomputed which refers to the mapping; it must not outlive this object. */
+    inline Precomputed table() const GOLDILOCKS_NOEXCEPT { return Precomputed(*table_); }
+
+    /** Fixed base scalarmul. */
+    inline Point operator* (const Scalar &s) const GOLDILOCKS_NOEXCEPT { Point r; goldilocks_448_precomputed_scalarmul(r.p,table_,s.s); return r; }
+};
+
 /** X-only Diffie-Hellman ladder functions */
 struct DhLadder {
 public:
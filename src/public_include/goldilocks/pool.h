@@ -0,0 +1,108 @@
+/**
+ * @file goldilocks/pool.h
+ * @copyright
+ *   Copyright (c) 2018 the libgoldilocks contributors.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief A thread pool for the batch APIs.
+ *
+ * Batch functions which take a goldilocks_pool_s split their work across
+ * the pool's threads.  Passing NULL instead runs them on the calling thread.
+ */
+
+#ifndef __GOLDILOCKS_POOL_H__
+#define __GOLDILOCKS_POOL_H__ 1
+
+#include <stddef.h>
+#include <goldilocks/common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A set of worker threads.
+ *
+ * Each worker owns a deque of work and steals from the others once its own
+ * runs dry, so uneven items (long messages, failed decodes) still keep every
+ * thread busy.  Each worker also owns its scratch memory.  Jobs from several
+ * threads may share a pool; they take turns.
+ */
+typedef struct goldilocks_pool_s goldilocks_pool_s;
+
+/**
+ * @brief A unit of work: items first to first+count-1 of a job.
+ *
+ * @param [in] ctx The job's context.
+ * @param [in] first The first item.
+ * @param [in] count The number of items.
+ * @param [in] scratch This worker's scratch memory, aligned to 64 bytes,
+ * or NULL if the job asked for none.  It is wiped after the job.
+ */
+typedef void (*goldilocks_pool_task_t) (
+    void *ctx,
+    size_t first,
+    size_t count,
+    void *scratch
+);
+
+/**
+ * @brief Create a thread pool.
+ *
+ * @param [in] nthreads The number of threads which run jobs, counting the
+ * thread which submits them, or 0 for one per online CPU.
+ *
+ * @return The new pool, or NULL if it could not be created.
+ */
+goldilocks_pool_s *goldilocks_pool_create (
+    unsigned int nthreads
+) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Stop a pool's threads and free it.
+ *
+ * @param [in] pool The pool to destroy.  May be NULL.
+ */
+void goldilocks_pool_destroy (
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief The number of threads which run a pool's jobs.
+ *
+ * @param [in] pool The pool.  If NULL, this returns 1.
+ */
+unsigned int goldilocks_pool_threads (
+    const goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS GOLDILOCKS_NOINLINE;
+
+/**
+ * @brief Run a job of n items on a pool, and wait for it to finish.
+ *
+ * The calling thread works on the job too.  Tasks must not run jobs on the
+ * same pool.
+ *
+ * @param [in] pool The pool.  If NULL, the job runs on the calling thread.
+ * @param [in] n The number of items.
+ * @param [in] grain The number of items per task, or 0 to choose one.
+ * @param [in] scratch_bytes The size of the scratch memory each worker needs.
+ * @param [in] task The function which does the work.
+ * @param [in] ctx Its context.
+ *
+ * @retval GOLDILOCKS_SUCCESS The job ran.
+ * @retval GOLDILOCKS_FAILURE No worker could allocate its scratch memory, so
+ * nothing ran.
+ */
+goldilocks_error_t goldilocks_pool_run (
+    goldilocks_pool_s *pool,
+    size_t n,
+    size_t grain,
+    size_t scratch_bytes,
+    goldilocks_pool_task_t task,
+    void *ctx
+) GOLDILOCKS_API_VIS __attribute__((nonnull(5))) GOLDILOCKS_NOINLINE;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __GOLDILOCKS_POOL_H__ */
@@ -0,0 +1,55 @@
+/**
+ * @file goldilocks/pool.hxx
+ * @copyright
+ *   Copyright (c) 2018 the libgoldilocks contributors.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Thread pool for the batch APIs, C++ wrapper.
+ */
+
+#ifndef __GOLDILOCKS_POOL_HXX__
+#define __GOLDILOCKS_POOL_HXX__ 1
+
+#include <goldilocks/pool.h>
+#include <goldilocks/secure_buffer.hxx>
+#include <new>
+
+/** @cond internal */
+#if __cplusplus >= 201103L
+#define GOLDILOCKS_NOEXCEPT noexcept
+#else
+#define GOLDILOCKS_NOEXCEPT throw()
+#endif
+/** @endcond */
+
+namespace goldilocks {
+
+/** A thread pool.  Pass get() to the batch functions. */
+class ThreadPool {
+private:
+    /** @cond internal */
+    goldilocks_pool_s *pool_;
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+    /** @endcond */
+public:
+    /** Start a pool of nthreads threads, counting the caller, or one per online CPU. */
+    inline explicit ThreadPool(unsigned int nthreads = 0) /*throw(std::bad_alloc)*/
+        : pool_(goldilocks_pool_create(nthreads)) {
+        if (pool_ == NULL) throw std::bad_alloc();
+    }
+
+    /** Stop the threads. */
+    inline ~ThreadPool() GOLDILOCKS_NOEXCEPT { goldilocks_pool_destroy(pool_); }
+
+    /** The number of threads which run jobs. */
+    inline unsigned int threads() const GOLDILOCKS_NOEXCEPT { return goldilocks_pool_threads(pool_); }
+
+    /** The C handle. */
+    inline goldilocks_pool_s *get() const GOLDILOCKS_NOEXCEPT { return pool_; }
+};
+
+} /* namespace goldilocks */
+
+#undef GOLDILOCKS_NOEXCEPT
+
+#endif /* __GOLDILOCKS_POOL_HXX__ */
@@ -370,6 +370,16 @@ public:
     inline explicit FixedArrayBuffer(const FixedArrayBuffer<Size> &b) GOLDILOCKS_NOEXCEPT : FixedBuffer<Size>(storage,true) {
         memcpy(storage,b.data(),Size);
     }
+
+#if __cplusplus >= 201103L
+    /** Move constructor, so that fixed buffers can be returned by value.
+     * The storage is inline, so this copies it and zeroizes the source.
+     */
+    inline FixedArrayBuffer(FixedArrayBuffer<Size> &&b) GOLDILOCKS_NOEXCEPT : FixedBuffer<Size>(storage,true) {
+        memcpy(storage,b.data(),Size);
+        b.zeroize();
+    }
+#endif
     
     /** Destroy the buffer */
     ~FixedArrayBuffer() GOLDILOCKS_NOEXCEPT { zeroize(); }
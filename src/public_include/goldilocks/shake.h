@@ -6,7 +6,7 @@
  *   Copyright (c) 2018 the libgoldilocks contributors.  \n
  *   Released under the MIT License.  See LICENSE.txt for license information.
  * @author Mike Hamburg
- * @brief SHA-3-n and GOLDILOCKS_SHAKE-n instances.
+ * @brief SHA-3-n, GOLDILOCKS_SHAKE-n, TurboSHAKE-n, KangarooTwelve and SP 800-185 instances.
  */
 
 #ifndef __GOLDILOCKS_SHAKE_H__
@@ -17,6 +17,7 @@
 #include <stdlib.h> /* for NULL */
 
 #include <goldilocks/common.h>
+#include <goldilocks/pool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -147,6 +148,45 @@ goldilocks_error_t goldilocks_sha3_hash (
     const struct goldilocks_kparams_s *params
 ) GOLDILOCKS_API_VIS;
 
+/**
+ * @brief Hash many inputs, splitting the work across a pool.  Each output
+ * is the one goldilocks_sha3_hash would compute.
+ * @param [out] out n outputs of outlen bytes, back to back.
+ * @param [in] outlen The length of each output.
+ * @param [in] in The n inputs.
+ * @param [in] inlens Their lengths.
+ * @param [in] n The number of inputs.
+ * @param [in] params The parameters of the sponge hash.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ * @return GOLDILOCKS_FAILURE if goldilocks_sha3_hash would fail, or if
+ * memory for the sponges could not be allocated.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_sha3_hash_batch (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *const in[],
+    const size_t inlens[],
+    size_t n,
+    const struct goldilocks_kparams_s *params,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Initialize a TurboSHAKE sponge with a domain separation byte other
+ * than the default 0x1F.
+ * @param [out] sponge The object to initialize.
+ * @param [in] params GOLDILOCKS_TURBOSHAKE128_params_s or GOLDILOCKS_TURBOSHAKE256_params_s.
+ * @param [in] domain The domain separation byte, from 0x01 to 0x7F.
+ * @return GOLDILOCKS_FAILURE if the domain byte is out of range.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_turboshake_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    uint8_t domain
+) GOLDILOCKS_API_VIS;
+
 /* FUTURE: expand/doxygenate individual GOLDILOCKS_SHAKE/GOLDILOCKS_SHA3 instances? */
 
 /** @cond internal */
@@ -202,6 +242,31 @@ goldilocks_error_t goldilocks_sha3_hash (
     static inline void GOLDILOCKS_NONNULL goldilocks_sha3_##n##_destroy(goldilocks_sha3_##n##_ctx_p sponge) { \
         goldilocks_sha3_destroy(sponge->s); \
     }
+
+#define GOLDILOCKS_DEC_TURBOSHAKE(n) \
+    extern const struct goldilocks_kparams_s GOLDILOCKS_TURBOSHAKE##n##_params_s GOLDILOCKS_API_VIS; \
+    typedef struct goldilocks_turboshake##n##_ctx_s { goldilocks_keccak_sponge_p s; } goldilocks_turboshake##n##_ctx_p[1]; \
+    static inline void GOLDILOCKS_NONNULL goldilocks_turboshake##n##_init(goldilocks_turboshake##n##_ctx_p sponge) { \
+        goldilocks_sha3_init(sponge->s, &GOLDILOCKS_TURBOSHAKE##n##_params_s); \
+    } \
+    static inline goldilocks_error_t GOLDILOCKS_NONNULL goldilocks_turboshake##n##_init_with_domain(goldilocks_turboshake##n##_ctx_p sponge, uint8_t domain) { \
+        return goldilocks_turboshake_init(sponge->s, &GOLDILOCKS_TURBOSHAKE##n##_params_s, domain); \
+    } \
+    static inline void GOLDILOCKS_NONNULL goldilocks_turboshake##n##_gen_init(goldilocks_keccak_sponge_p sponge) { \
+        goldilocks_sha3_init(sponge, &GOLDILOCKS_TURBOSHAKE##n##_params_s); \
+    } \
+    static inline goldilocks_error_t GOLDILOCKS_NONNULL goldilocks_turboshake##n##_update(goldilocks_turboshake##n##_ctx_p sponge, const uint8_t *in, size_t inlen ) { \
+        return goldilocks_sha3_update(sponge->s, in, inlen); \
+    } \
+    static inline void  GOLDILOCKS_NONNULL goldilocks_turboshake##n##_output(goldilocks_turboshake##n##_ctx_p sponge, uint8_t *out, size_t outlen ) { \
+        goldilocks_sha3_output(sponge->s, out, outlen); \
+    } \
+    static inline void  GOLDILOCKS_NONNULL goldilocks_turboshake##n##_hash(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen) { \
+        goldilocks_sha3_hash(out,outlen,in,inlen,&GOLDILOCKS_TURBOSHAKE##n##_params_s); \
+    } \
+    static inline void  GOLDILOCKS_NONNULL goldilocks_turboshake##n##_destroy(goldilocks_turboshake##n##_ctx_p sponge) { \
+        goldilocks_sha3_destroy(sponge->s); \
+    }
 /** @endcond */
 
 GOLDILOCKS_DEC_SHAKE(128)
@@ -210,8 +275,311 @@ GOLDILOCKS_DEC_SHA3(224)
 GOLDILOCKS_DEC_SHA3(256)
 GOLDILOCKS_DEC_SHA3(384)
 GOLDILOCKS_DEC_SHA3(512)
+GOLDILOCKS_DEC_TURBOSHAKE(128)
+GOLDILOCKS_DEC_TURBOSHAKE(256)
 #undef GOLDILOCKS_DEC_SHAKE
 #undef GOLDILOCKS_DEC_SHA3
+#undef GOLDILOCKS_DEC_TURBOSHAKE
+
+/** KangarooTwelve (KT128) hash context. */
+typedef struct goldilocks_kangarootwelve_ctx_s {
+    /** @cond internal */
+    goldilocks_keccak_sponge_p node, leaf;
+    uint64_t chunk_bytes, leaves;
+    /** @endcond */
+} goldilocks_kangarootwelve_ctx_s, goldilocks_kangarootwelve_ctx_p[1];
+
+/**
+ * @brief Initialize a KangarooTwelve context.
+ * @param [out] ctx The context.
+ */
+void goldilocks_kangarootwelve_init (
+    goldilocks_kangarootwelve_ctx_p ctx
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Absorb message data into a KangarooTwelve context.
+ * @param [inout] ctx The context.
+ * @param [in] in The input data.
+ * @param [in] len The input data's length in bytes.
+ * @return GOLDILOCKS_FAILURE if the context has already been used for output.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_update (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    const uint8_t *in,
+    size_t len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Finish the message with a customization string.  If this isn't
+ * called, the first output call uses an empty customization string.
+ * @param [inout] ctx The context.
+ * @param [in] custom The customization string.
+ * @param [in] custom_len The customization string's length in bytes.
+ * @return GOLDILOCKS_FAILURE if the context has already been used for output.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_customize (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    const uint8_t *custom,
+    size_t custom_len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Squeeze output from a KangarooTwelve context.  This can be called
+ * more times to extend the output.
+ * @param [inout] ctx The context.
+ * @param [out] out The output data.
+ * @param [in] len The requested output data length in bytes.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_output (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    uint8_t * __restrict__ out,
+    size_t len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Squeeze output from a KangarooTwelve context and re-initialize it.
+ * @param [inout] ctx The context.
+ * @param [out] out The output data.
+ * @param [in] len The requested output data length in bytes.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_final (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    uint8_t * __restrict__ out,
+    size_t len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Destroy a KangarooTwelve context by overwriting it with 0.
+ * @param [out] ctx The context.
+ */
+void goldilocks_kangarootwelve_destroy (
+    goldilocks_kangarootwelve_ctx_p ctx
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Hash (in) to (out) with KangarooTwelve.
+ * @param [out] out A buffer for the output data.
+ * @param [in] outlen The length of the output data.
+ * @param [in] in The input data.
+ * @param [in] inlen The length of the input data.
+ * @param [in] custom The customization string.
+ * @param [in] custom_len The length of the customization string.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_hash (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    const uint8_t *custom,
+    size_t custom_len
+) GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Hash (in) to (out) with KangarooTwelve, hashing the tree's leaves
+ * on a pool.  The output is the same as goldilocks_kangarootwelve_hash.
+ * @param [out] out A buffer for the output data.
+ * @param [in] outlen The length of the output data.
+ * @param [in] in The input data.
+ * @param [in] inlen The length of the input data.
+ * @param [in] custom The customization string.
+ * @param [in] custom_len The length of the customization string.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ */
+goldilocks_error_t goldilocks_kangarootwelve_hash_parallel (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Hash (in) to (out) with ParallelHash256 from NIST SP 800-185.
+ * The input is split into blocks which are hashed on a pool.
+ * @param [out] out A buffer for the output data.
+ * @param [in] outlen The length of the output data.
+ * @param [in] in The input data.
+ * @param [in] inlen The length of the input data.
+ * @param [in] block_size The block size B in bytes.  Must be nonzero.
+ * @param [in] custom The customization string S.
+ * @param [in] custom_len The length of the customization string.
+ * @param [in] pool The thread pool, or NULL to run on the calling thread.
+ * @return GOLDILOCKS_FAILURE if block_size is 0.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_parallelhash256 (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    size_t block_size,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Hash (in) to (out) with ParallelHashXOF256 from NIST SP 800-185.
+ * Same parameters as goldilocks_parallelhash256.
+ */
+goldilocks_error_t goldilocks_parallelhash256_xof (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    size_t block_size,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Initialize a cSHAKE sponge from NIST SP 800-185.  Absorb and
+ * squeeze it with goldilocks_sha3_update and goldilocks_sha3_output.  With
+ * an empty name and customization string, this is plain SHAKE.
+ * @param [out] sponge The object to initialize.
+ * @param [in] params GOLDILOCKS_SHAKE128_params_s or GOLDILOCKS_SHAKE256_params_s.
+ * @param [in] name The function name N.
+ * @param [in] name_len The length of the function name.
+ * @param [in] custom The customization string S.
+ * @param [in] custom_len The length of the customization string.
+ */
+void goldilocks_cshake_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *name,
+    size_t name_len,
+    const uint8_t *custom,
+    size_t custom_len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2)));
+
+/**
+ * @brief A KMAC key from NIST SP 800-185, prepared for repeated use.  It
+ * holds the sponge state after the padded key block, so that each MAC
+ * starts from a copy instead of absorbing the key again.
+ */
+typedef struct goldilocks_kmac_key_s {
+    /** @cond internal */
+    goldilocks_keccak_sponge_p keyed;
+    /** @endcond */
+} goldilocks_kmac_key_s, goldilocks_kmac_key_p[1];
+
+/**
+ * @brief Prepare a KMAC key.
+ * @param [out] prepared The prepared key.
+ * @param [in] params GOLDILOCKS_SHAKE128_params_s for KMAC128, or
+ * GOLDILOCKS_SHAKE256_params_s for KMAC256.
+ * @param [in] key The key K.
+ * @param [in] key_len The length of the key.
+ * @param [in] custom The customization string S.
+ * @param [in] custom_len The length of the customization string.
+ */
+void goldilocks_kmac_key_init (
+    goldilocks_kmac_key_p prepared,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *key,
+    size_t key_len,
+    const uint8_t *custom,
+    size_t custom_len
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1,2)));
+
+/**
+ * @brief Destroy a prepared KMAC key by overwriting it with 0.
+ * @param [out] prepared The prepared key.
+ */
+void goldilocks_kmac_key_destroy (
+    goldilocks_kmac_key_p prepared
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Start a KMAC computation from a prepared key.  Absorb the message
+ * with goldilocks_sha3_update.
+ * @param [out] sponge The sponge to start.
+ * @param [in] prepared The prepared key.
+ */
+void goldilocks_kmac_init (
+    goldilocks_keccak_sponge_p sponge,
+    const goldilocks_kmac_key_p prepared
+) GOLDILOCKS_API_VIS GOLDILOCKS_NONNULL;
+
+/**
+ * @brief Finish a KMAC computation with an output of outlen bytes.  The
+ * output length is part of the MAC, so this can only be called once.
+ * @param [inout] sponge The sponge, started with goldilocks_kmac_init.
+ * @param [out] out The output data.
+ * @param [in] outlen The output length.
+ * @return GOLDILOCKS_FAILURE if output has already started.
+ * @return GOLDILOCKS_SUCCESS otherwise.
+ */
+goldilocks_error_t goldilocks_kmac_output (
+    goldilocks_keccak_sponge_p sponge,
+    uint8_t * __restrict__ out,
+    size_t outlen
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Squeeze KMACXOF output.  This can be called more times to extend
+ * the output.
+ * @param [inout] sponge The sponge, started with goldilocks_kmac_init.
+ * @param [out] out The output data.
+ * @param [in] outlen The output length.
+ */
+void goldilocks_kmac_xof_output (
+    goldilocks_keccak_sponge_p sponge,
+    uint8_t * __restrict__ out,
+    size_t outlen
+) GOLDILOCKS_API_VIS __attribute__((nonnull(1)));
+
+/**
+ * @brief Compute KMAC of (in) to (out) under a prepared key.
+ * @param [out] out A buffer for the output data.
+ * @param [in] outlen The length of the output data.
+ * @param [in] prepared The prepared key.
+ * @param [in] in The input data.
+ * @param [in] inlen The length of the input data.
+ */
+void goldilocks_kmac (
+    uint8_t *out,
+    size_t outlen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) GOLDILOCKS_API_VIS __attribute__((nonnull(3)));
+
+/**
+ * @brief Compute KMACXOF of (in) to (out) under a prepared key.
+ * Same parameters as goldilocks_kmac.
+ */
+void goldilocks_kmac_xof (
+    uint8_t *out,
+    size_t outlen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) GOLDILOCKS_API_VIS __attribute__((nonnull(3)));
+
+/**
+ * @brief Check a KMAC tag in constant time.
+ * @param [in] tag The tag.
+ * @param [in] taglen The length of the tag, which is also the KMAC output length.
+ * @param [in] prepared The prepared key.
+ * @param [in] in The input data.
+ * @param [in] inlen The length of the input data.
+ * @return GOLDILOCKS_SUCCESS if the tag is KMAC of (in) under the key.
+ * @return GOLDILOCKS_FAILURE otherwise.
+ */
+goldilocks_error_t goldilocks_kmac_verify (
+    const uint8_t *tag,
+    size_t taglen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) GOLDILOCKS_API_VIS __attribute__((nonnull(3))) GOLDILOCKS_WARN_UNUSED;
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -6,7 +6,7 @@
  *   Copyright (c) 2018 the libgoldilocks contributors.  \n
  *   Released under the MIT License.  See LICENSE.txt for license information.
  * @author Mike Hamburg
- * @brief SHA-3-n and SHAKE-n instances, C++ wrapper.
+ * @brief SHA-3-n, SHAKE-n, TurboSHAKE-n and KangarooTwelve instances, C++ wrapper.
  */
 
 #ifndef __GOLDILOCKS_SHAKE_HXX__
@@ -174,13 +174,338 @@ public:
     }
 };
 
+/** Variable-output-length TurboSHAKE: SHAKE with 12 rounds of Keccak */
+template<int bits>
+class TurboSHAKE : public KeccakHash {
+private:
+    /** Get the parameter template block for this hash */
+    static inline const struct goldilocks_kparams_s *get_params();
+
+public:
+    /** Number of bytes of output */
+#if __cplusplus >= 201103L
+    static const size_t MAX_OUTPUT_BYTES = SIZE_MAX;
+#else
+    static const size_t MAX_OUTPUT_BYTES = (size_t)-1;
+#endif
+
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = bits/4;
+
+    /** Default domain separation byte */
+    static const uint8_t DEFAULT_DOMAIN = 0x1F;
+
+    /** Initializer */
+    inline TurboSHAKE() GOLDILOCKS_NOEXCEPT : KeccakHash(get_params()) {}
+
+    /** Initializer with a domain separation byte.
+     * @throw LengthException if domain is not between 0x01 and 0x7F.
+     */
+    inline explicit TurboSHAKE(uint8_t domain) /*throw(LengthException)*/ : KeccakHash(get_params()) {
+        if (GOLDILOCKS_SUCCESS != goldilocks_turboshake_init(wrapped, get_params(), domain)) {
+            throw LengthException();
+        }
+    }
+
+    /** Hash bytes with this TurboSHAKE instance */
+    static inline SecureBuffer hash(const Block &b, size_t outlen, uint8_t domain = DEFAULT_DOMAIN) /*throw(std::bad_alloc, LengthException)*/ {
+        TurboSHAKE s(domain); s += b; return s.output(outlen);
+    }
+};
+
+/** KangarooTwelve (KT128), a tree hash built on TurboSHAKE128 */
+class KangarooTwelve {
+private:
+    /** The C-wrapper hash state */
+    goldilocks_kangarootwelve_ctx_p wrapped;
+
+public:
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = 32;
+
+    /** Initializer */
+    inline KangarooTwelve() GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_init(wrapped); }
+
+    /** Add more data to running hash */
+    inline void update(const uint8_t *__restrict__ in, size_t len) GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_update(wrapped,in,len); }
+
+    /** Add more data to running hash, C++ version. */
+    inline void update(const Block &s) GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_update(wrapped,s.data(),s.size()); }
+
+    /** Add more data, stream version. */
+    inline KangarooTwelve &operator<<(const Block &s) GOLDILOCKS_NOEXCEPT { update(s); return *this; }
+
+    /** Same as <<. */
+    inline KangarooTwelve &operator+=(const Block &s) GOLDILOCKS_NOEXCEPT { return *this << s; }
+
+    /** @brief Finish the message with a customization string.
+     * @throw CryptoException if output has already started.
+     */
+    inline void customize(const Block &custom) /*throw(CryptoException)*/ {
+        if (GOLDILOCKS_SUCCESS != goldilocks_kangarootwelve_customize(wrapped,custom.data(),custom.size())) {
+            throw CryptoException();
+        }
+    }
+
+    /** @brief Output bytes from the hash. */
+    inline void output(Buffer b) GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_output(wrapped,b.data(),b.size()); }
+
+    /** @brief Output bytes from the hash. */
+    inline SecureBuffer output(size_t len = DEFAULT_OUTPUT_BYTES) /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(len);
+        output(buffer);
+        return buffer;
+    }
+
+    /** @brief Output bytes from the hash and reinitialize it. */
+    inline void final(Buffer b) GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_final(wrapped,b.data(),b.size()); }
+
+    /** @brief Output bytes from the hash and reinitialize it. */
+    inline SecureBuffer final(size_t len = DEFAULT_OUTPUT_BYTES) /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(len);
+        final(buffer);
+        return buffer;
+    }
+
+    /** Reset the hash to the empty string */
+    inline void reset() GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_init(wrapped); }
+
+    /** Hash bytes with KangarooTwelve */
+    static inline SecureBuffer hash(const Block &b, size_t outlen = DEFAULT_OUTPUT_BYTES, const Block &custom = Block()) /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(outlen);
+        goldilocks_kangarootwelve_hash(buffer.data(),outlen,b.data(),b.size(),custom.data(),custom.size());
+        return buffer;
+    }
+
+    /** Hash bytes with KangarooTwelve, hashing the leaves on a pool */
+    static inline SecureBuffer hash_parallel(
+        const Block &b, size_t outlen = DEFAULT_OUTPUT_BYTES, const Block &custom = Block(), goldilocks_pool_s *pool = NULL
+    ) /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(outlen);
+        goldilocks_kangarootwelve_hash_parallel(buffer.data(),outlen,b.data(),b.size(),custom.data(),custom.size(),pool);
+        return buffer;
+    }
+
+    /** Destructor zeroizes state */
+    inline ~KangarooTwelve() GOLDILOCKS_NOEXCEPT { goldilocks_kangarootwelve_destroy(wrapped); }
+
+private:
+    KangarooTwelve(const KangarooTwelve &) GOLDILOCKS_DELETE;
+    KangarooTwelve &operator=(const KangarooTwelve &) GOLDILOCKS_DELETE;
+};
+
+/** ParallelHash256 and ParallelHashXOF256 from NIST SP 800-185 */
+class ParallelHash256 {
+public:
+    /** Default block size in bytes */
+    static const size_t DEFAULT_BLOCK_BYTES = 8192;
+
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = 64;
+
+    /** Hash bytes with ParallelHash256, hashing the blocks on a pool.
+     * @throw LengthException if block_size is 0.
+     */
+    static inline SecureBuffer hash(
+        const Block &b, size_t outlen = DEFAULT_OUTPUT_BYTES, const Block &custom = Block(),
+        size_t block_size = DEFAULT_BLOCK_BYTES, goldilocks_pool_s *pool = NULL
+    ) /*throw(std::bad_alloc, LengthException)*/ {
+        SecureBuffer buffer(outlen);
+        if (GOLDILOCKS_SUCCESS != goldilocks_parallelhash256(
+            buffer.data(),outlen,b.data(),b.size(),block_size,custom.data(),custom.size(),pool
+        )) {
+            throw LengthException();
+        }
+        return buffer;
+    }
+
+    /** Hash bytes with ParallelHashXOF256, hashing the blocks on a pool.
+     * @throw LengthException if block_size is 0.
+     */
+    static inline SecureBuffer hash_xof(
+        const Block &b, size_t outlen = DEFAULT_OUTPUT_BYTES, const Block &custom = Block(),
+        size_t block_size = DEFAULT_BLOCK_BYTES, goldilocks_pool_s *pool = NULL
+    ) /*throw(std::bad_alloc, LengthException)*/ {
+        SecureBuffer buffer(outlen);
+        if (GOLDILOCKS_SUCCESS != goldilocks_parallelhash256_xof(
+            buffer.data(),outlen,b.data(),b.size(),block_size,custom.data(),custom.size(),pool
+        )) {
+            throw LengthException();
+        }
+        return buffer;
+    }
+};
+
+/** cSHAKE from NIST SP 800-185: SHAKE with a function name and a customization string */
+template<int bits>
+class cSHAKE : public KeccakHash {
+private:
+    /** Get the parameter template block for this hash */
+    static inline const struct goldilocks_kparams_s *get_params();
+
+    /** The state after the name and customization string, for reset() */
+    goldilocks_keccak_sponge_p start;
+
+public:
+    /** Number of bytes of output */
+#if __cplusplus >= 201103L
+    static const size_t MAX_OUTPUT_BYTES = SIZE_MAX;
+#else
+    static const size_t MAX_OUTPUT_BYTES = (size_t)-1;
+#endif
+
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = bits/4;
+
+    /** Initializer */
+    inline explicit cSHAKE(const Block &custom = Block(), const Block &name = Block()) GOLDILOCKS_NOEXCEPT
+        : KeccakHash(get_params()) {
+        goldilocks_cshake_init(wrapped, get_params(), name.data(), name.size(), custom.data(), custom.size());
+        start[0] = wrapped[0];
+    }
+
+    /** Reset the hash to the empty string, keeping the name and customization string */
+    inline void reset() GOLDILOCKS_NOEXCEPT { wrapped[0] = start[0]; }
+
+    /** @brief Output bytes from the sponge and reset it. */
+    inline void final(Buffer b) /*throw(LengthException)*/ { output(b); reset(); }
+
+    /** @brief Output bytes from the sponge and reset it. */
+    inline SecureBuffer final(size_t len = DEFAULT_OUTPUT_BYTES) /*throw(std::bad_alloc, LengthException)*/ {
+        SecureBuffer buffer = output(len); reset(); return buffer;
+    }
+
+    /** Hash bytes with this cSHAKE instance */
+    static inline SecureBuffer hash(
+        const Block &b, size_t outlen, const Block &custom = Block(), const Block &name = Block()
+    ) /*throw(std::bad_alloc)*/ {
+        cSHAKE s(custom, name); s += b; return s.output(outlen);
+    }
+
+    /** Destructor zeroizes state */
+    inline ~cSHAKE() GOLDILOCKS_NOEXCEPT { goldilocks_sha3_destroy(start); }
+};
+
+template<int bits> class KMAC;
+
+/** A KMAC key from NIST SP 800-185, absorbed once so that each MAC starts from a copy */
+template<int bits>
+class KmacKey {
+private:
+    /** @cond internal */
+    /** Get the parameter template block for this MAC */
+    static inline const struct goldilocks_kparams_s *get_params();
+
+    /** The C-wrapper prepared key */
+    goldilocks_kmac_key_p wrapped;
+    friend class KMAC<bits>;
+    /** @endcond */
+
+public:
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = bits/4;
+
+    /** Prepare a key, with an optional customization string */
+    inline explicit KmacKey(const Block &key, const Block &custom = Block()) GOLDILOCKS_NOEXCEPT {
+        goldilocks_kmac_key_init(wrapped, get_params(), key.data(), key.size(), custom.data(), custom.size());
+    }
+
+    /** KMAC of a message */
+    inline SecureBuffer mac(const Block &msg, size_t outlen = DEFAULT_OUTPUT_BYTES) const /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(outlen);
+        goldilocks_kmac(buffer.data(), outlen, wrapped, msg.data(), msg.size());
+        return buffer;
+    }
+
+    /** KMACXOF of a message */
+    inline SecureBuffer mac_xof(const Block &msg, size_t outlen = DEFAULT_OUTPUT_BYTES) const /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(outlen);
+        goldilocks_kmac_xof(buffer.data(), outlen, wrapped, msg.data(), msg.size());
+        return buffer;
+    }
+
+    /** @brief Check a KMAC tag in constant time.
+     * @throw CryptoException if the tag is wrong.
+     */
+    inline void verify(const Block &tag, const Block &msg) const /*throw(CryptoException)*/ {
+        if (GOLDILOCKS_SUCCESS != goldilocks_kmac_verify(tag.data(), tag.size(), wrapped, msg.data(), msg.size())) {
+            throw CryptoException();
+        }
+    }
+
+    /** Destructor zeroizes state */
+    inline ~KmacKey() GOLDILOCKS_NOEXCEPT { goldilocks_kmac_key_destroy(wrapped); }
+
+private:
+    KmacKey(const KmacKey &) GOLDILOCKS_DELETE;
+    KmacKey &operator=(const KmacKey &) GOLDILOCKS_DELETE;
+};
+
+/** Incremental KMAC under a prepared key */
+template<int bits>
+class KMAC {
+private:
+    /** The C-wrapper sponge state */
+    goldilocks_keccak_sponge_p wrapped;
+
+public:
+    /** Default number of bytes to output */
+    static const size_t DEFAULT_OUTPUT_BYTES = bits/4;
+
+    /** Start from a prepared key */
+    inline explicit KMAC(const KmacKey<bits> &key) GOLDILOCKS_NOEXCEPT { goldilocks_kmac_init(wrapped, key.wrapped); }
+
+    /** Add more data to running MAC */
+    inline void update(const uint8_t *__restrict__ in, size_t len) GOLDILOCKS_NOEXCEPT { goldilocks_sha3_update(wrapped,in,len); }
+
+    /** Add more data to running MAC, C++ version. */
+    inline void update(const Block &s) GOLDILOCKS_NOEXCEPT { goldilocks_sha3_update(wrapped,s.data(),s.size()); }
+
+    /** Add more data, stream version. */
+    inline KMAC &operator<<(const Block &s) GOLDILOCKS_NOEXCEPT { update(s); return *this; }
+
+    /** Same as <<. */
+    inline KMAC &operator+=(const Block &s) GOLDILOCKS_NOEXCEPT { return *this << s; }
+
+    /** @brief Output the MAC.  The length is part of the MAC, so this can only be called once.
+     * @throw CryptoException if output has already started.
+     */
+    inline SecureBuffer output(size_t len = DEFAULT_OUTPUT_BYTES) /*throw(std::bad_alloc, CryptoException)*/ {
+        SecureBuffer buffer(len);
+        if (GOLDILOCKS_SUCCESS != goldilocks_kmac_output(wrapped,buffer.data(),len)) {
+            throw CryptoException();
+        }
+        return buffer;
+    }
+
+    /** @brief Output KMACXOF bytes.  This can be called more times to extend the output. */
+    inline SecureBuffer output_xof(size_t len = DEFAULT_OUTPUT_BYTES) /*throw(std::bad_alloc)*/ {
+        SecureBuffer buffer(len);
+        goldilocks_kmac_xof_output(wrapped,buffer.data(),len);
+        return buffer;
+    }
+
+    /** Destructor zeroizes state */
+    inline ~KMAC() GOLDILOCKS_NOEXCEPT { goldilocks_sha3_destroy(wrapped); }
+
+private:
+    KMAC(const KMAC &) GOLDILOCKS_DELETE;
+    KMAC &operator=(const KMAC &) GOLDILOCKS_DELETE;
+};
+
 /** @cond internal */
+template<> inline const struct goldilocks_kparams_s *TurboSHAKE<128>::get_params() { return &GOLDILOCKS_TURBOSHAKE128_params_s; }
+template<> inline const struct goldilocks_kparams_s *TurboSHAKE<256>::get_params() { return &GOLDILOCKS_TURBOSHAKE256_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHAKE<128>::get_params() { return &GOLDILOCKS_SHAKE128_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHAKE<256>::get_params() { return &GOLDILOCKS_SHAKE256_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHA3<224>::get_params() { return  &GOLDILOCKS_SHA3_224_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHA3<256>::get_params() { return  &GOLDILOCKS_SHA3_256_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHA3<384>::get_params() { return  &GOLDILOCKS_SHA3_384_params_s; }
 template<> inline const struct goldilocks_kparams_s *SHA3<512>::get_params() { return  &GOLDILOCKS_SHA3_512_params_s; }
+template<> inline const struct goldilocks_kparams_s *cSHAKE<128>::get_params() { return &GOLDILOCKS_SHAKE128_params_s; }
+template<> inline const struct goldilocks_kparams_s *cSHAKE<256>::get_params() { return &GOLDILOCKS_SHAKE256_params_s; }
+template<> inline const struct goldilocks_kparams_s *KmacKey<128>::get_params() { return &GOLDILOCKS_SHAKE128_params_s; }
+template<> inline const struct goldilocks_kparams_s *KmacKey<256>::get_params() { return &GOLDILOCKS_SHAKE256_params_s; }
 /** @endcond */
 
 } /* namespace goldilocks */
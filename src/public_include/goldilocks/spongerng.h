@@ -20,7 +20,7 @@ extern "C" {
 #endif
 
 /** Keccak CSPRNG structure as struct. */
-typedef struct {
+typedef struct goldilocks_keccak_prng_s {
     goldilocks_keccak_sponge_p sponge;  /**< Internal sponge object. */
 } goldilocks_keccak_prng_s;
 
@@ -72,6 +72,193 @@ void goldilocks_spongerng_stir (
     size_t len                       /**< [in]  The length of the initial data. */
 ) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
 
+/** Size of the output block that a buffered CSPRNG serves small requests from. */
+#define GOLDILOCKS_SPONGERNG_BUFFER_BYTES 4096
+
+/** Default output budget after which a nondeterministic buffered CSPRNG reseeds. */
+#define GOLDILOCKS_SPONGERNG_RESEED_BYTES ((uint64_t)1<<20)
+
+/** Default time budget, in seconds, after which a nondeterministic buffered CSPRNG reseeds. */
+#define GOLDILOCKS_SPONGERNG_RESEED_SECONDS 60
+
+/**
+ * @brief Buffered Keccak CSPRNG structure as struct.
+ *
+ * Small requests are served from a block of output, so that they cost a
+ * memcpy instead of a stir.  Served bytes are erased from the block, and
+ * the underlying sponge ratchets on every refill, so a later compromise
+ * of the state does not reveal earlier outputs.
+ */
+typedef struct {
+    goldilocks_keccak_prng_p rng;  /**< Underlying sponge RNG. */
+    uint8_t buffer[GOLDILOCKS_SPONGERNG_BUFFER_BYTES]; /**< Output not yet served. */
+    size_t position;               /**< Bytes of the buffer already served and erased. */
+    uint64_t reseed_bytes;         /**< Reseed after this much output; 0 for never. */
+    uint64_t reseed_seconds;       /**< Reseed after this much time; 0 for never. */
+    uint64_t since_reseed;         /**< Bytes refilled since the last reseed. */
+    uint64_t last_reseed;          /**< Time of the last reseed. */
+    uint64_t fork_generation;      /**< Process generation when last seeded. */
+    uint64_t reseeds;              /**< Number of reseeds since initialization. */
+    int reseed_error;              /**< errno from the last failed reseed, or 0 if none failed. */
+    int deterministic;             /**< If nonzero, never reseed or react to fork. */
+} goldilocks_keccak_buffered_prng_s;
+
+/** Buffered Keccak CSPRNG structure as one-element array */
+typedef goldilocks_keccak_buffered_prng_s goldilocks_keccak_buffered_prng_p[1];
+
+/**
+ * @brief Initialize a buffered CSPRNG from a buffer.
+ * @note A nondeterministic buffered CSPRNG reseeds from /dev/urandom on its
+ * byte and time budgets, and after a fork.  A deterministic one never does,
+ * and its output doesn't depend on how it is split into requests.
+ */
+void goldilocks_spongerng_buffered_init_from_buffer (
+    goldilocks_keccak_buffered_prng_p prng, /**< [out] The PRNG object. */
+    const uint8_t *__restrict__ in,         /**< [in]  The initialization data. */
+    size_t len,                             /**< [in]  The length of the initialization data. */
+    int deterministic                       /**< [in]  If zero, reseed and stir in nondeterministic data. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Initialize a nondeterministic buffered CSPRNG from /dev/urandom.
+ * @retval GOLDILOCKS_SUCCESS success.
+ * @retval GOLDILOCKS_FAILURE failure.
+ * @note On failure, errno can be used to determine the cause.
+ */
+goldilocks_error_t goldilocks_spongerng_buffered_init_from_dev_urandom (
+    goldilocks_keccak_buffered_prng_p prng /**< [out] The PRNG object. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED;
+
+/** Set the budgets after which a nondeterministic buffered CSPRNG reseeds. */
+void goldilocks_spongerng_buffered_set_reseed (
+    goldilocks_keccak_buffered_prng_p prng, /**< [inout] The PRNG object. */
+    uint64_t reseed_bytes,                  /**< [in] Output budget in bytes, or 0 for none. */
+    uint64_t reseed_seconds                 /**< [in] Time budget in seconds, or 0 for none. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Check whether a buffered CSPRNG has been able to reseed.
+ * @retval GOLDILOCKS_SUCCESS every reseed since initialization read /dev/urandom.
+ * @retval GOLDILOCKS_FAILURE some reseed couldn't; its errno is in prng->reseed_error.
+ * @note A failed reseed still stirs in the time and process ID, so the output stays
+ * unpredictable to anyone who doesn't know the state, but it gets no fresh entropy.
+ */
+goldilocks_error_t goldilocks_spongerng_buffered_reseed_status (
+    const goldilocks_keccak_buffered_prng_p prng /**< [in] The PRNG object. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED;
+
+/** Output bytes from a buffered CSPRNG. */
+void goldilocks_spongerng_buffered_next (
+    goldilocks_keccak_buffered_prng_p prng, /**< [inout] The PRNG object. */
+    uint8_t * __restrict__ out,             /**< [out]   Output buffer. */
+    size_t len                              /**< [in]    Number of bytes to output. */
+) GOLDILOCKS_API_VIS;
+
+/** Securely destroy a buffered CSPRNG object by overwriting it. */
+void goldilocks_spongerng_buffered_destroy (
+    goldilocks_keccak_buffered_prng_p doomed /**< [in] The object to destroy. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Output bytes from this thread's buffered CSPRNG.
+ *
+ * The generator is created from /dev/urandom on first use in each thread,
+ * with the default reseed budgets, and destroyed when the thread exits.
+ *
+ * @retval GOLDILOCKS_SUCCESS success.
+ * @retval GOLDILOCKS_FAILURE the generator couldn't be created or seeded, or
+ * couldn't read /dev/urandom when it reseeded during this call.
+ */
+goldilocks_error_t goldilocks_spongerng_thread_next (
+    uint8_t * __restrict__ out, /**< [out] Output buffer. */
+    size_t len                  /**< [in]  Number of bytes to output. */
+) GOLDILOCKS_API_VIS GOLDILOCKS_WARN_UNUSED;
+
+/** Size of the independently generated blocks that make up a deterministic stream. */
+#define GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES 4096
+
+/**
+ * @brief Keyed root of a family of deterministic streams.
+ *
+ * Block j of stream i is KMACXOF256 under the root key, with customization
+ * "goldilocks stream rng", of left_encode(i) || left_encode(j).  Any block of
+ * any stream can therefore be generated on its own, in any order and on any
+ * thread, and the output never depends on how it was split up.  The root
+ * keeps the sponge state after the key block, so a block costs no more than
+ * its own output.
+ */
+typedef struct {
+    goldilocks_keccak_sponge_p keyed; /**< Sponge after absorbing the key block. */
+} goldilocks_keccak_stream_root_s;
+
+/** Keyed stream root as one-element array */
+typedef goldilocks_keccak_stream_root_s goldilocks_keccak_stream_root_p[1];
+
+/** One deterministic stream of a root, read sequentially. */
+typedef struct {
+    goldilocks_keccak_stream_root_p root; /**< Copy of the root. */
+    goldilocks_keccak_sponge_p block;     /**< Sponge squeezing the current block. */
+    uint64_t stream;                      /**< The stream's index. */
+    uint64_t next_block;                  /**< Index of the block after the current one. */
+    size_t remaining;                     /**< Bytes left in the current block. */
+} goldilocks_keccak_stream_prng_s;
+
+/** Deterministic stream as one-element array */
+typedef goldilocks_keccak_stream_prng_s goldilocks_keccak_stream_prng_p[1];
+
+/** Initialize a stream root from a key. */
+void goldilocks_spongerng_stream_root_init (
+    goldilocks_keccak_stream_root_p root, /**< [out] The root object. */
+    const uint8_t *key,                   /**< [in]  The key. */
+    size_t key_len                        /**< [in]  The length of the key. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/** Securely destroy a stream root by overwriting it. */
+void goldilocks_spongerng_stream_root_destroy (
+    goldilocks_keccak_stream_root_p doomed /**< [in] The object to destroy. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/**
+ * @brief Output bytes offset to offset+len-1 of a stream, splitting the
+ * blocks across a pool.
+ * @retval GOLDILOCKS_SUCCESS success.
+ * @retval GOLDILOCKS_FAILURE memory for the sponges could not be allocated.
+ */
+goldilocks_error_t goldilocks_spongerng_stream_read_at (
+    const goldilocks_keccak_stream_root_p root, /**< [in]  The root object. */
+    uint64_t stream,            /**< [in]  The stream's index. */
+    uint64_t offset,            /**< [in]  Position in the stream of the first byte. */
+    uint8_t * __restrict__ out, /**< [out] Output buffer. */
+    size_t len,                 /**< [in]  Number of bytes to output. */
+    goldilocks_pool_s *pool     /**< [in]  The thread pool, or NULL to run on the calling thread. */
+) __attribute__((nonnull(1))) GOLDILOCKS_API_VIS;
+
+/** Open stream number stream of a root, positioned at offset. */
+void goldilocks_spongerng_stream_init (
+    goldilocks_keccak_stream_prng_p prng,       /**< [out] The stream object. */
+    const goldilocks_keccak_stream_root_p root, /**< [in]  The root object. */
+    uint64_t stream,                            /**< [in]  The stream's index. */
+    uint64_t offset                             /**< [in]  Position of the first byte to output. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/** Jump to any position in a stream, forwards or backwards, in constant time. */
+void goldilocks_spongerng_stream_seek (
+    goldilocks_keccak_stream_prng_p prng, /**< [inout] The stream object. */
+    uint64_t offset                       /**< [in]    Position of the next byte to output. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
+/** Output the next bytes of a stream. */
+void goldilocks_spongerng_stream_next (
+    goldilocks_keccak_stream_prng_p prng, /**< [inout] The stream object. */
+    uint8_t * __restrict__ out,           /**< [out]   Output buffer. */
+    size_t len                            /**< [in]    Number of bytes to output. */
+) GOLDILOCKS_API_VIS;
+
+/** Securely destroy a stream object by overwriting it. */
+void goldilocks_spongerng_stream_destroy (
+    goldilocks_keccak_stream_prng_p doomed /**< [in] The object to destroy. */
+) GOLDILOCKS_NONNULL GOLDILOCKS_API_VIS;
+
 /** Securely destroy a sponge RNG object by overwriting it. */
 static GOLDILOCKS_INLINE void
 goldilocks_spongerng_destroy (
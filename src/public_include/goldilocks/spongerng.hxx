@@ -18,6 +18,7 @@
 #include <goldilocks/spongerng.h>
 
 #include <string>
+#include <new>
 #include <sys/types.h>
 #include <errno.h>
 
@@ -93,6 +94,127 @@ private:
     SpongeRng(const SpongeRng &) GOLDILOCKS_DELETE;
     SpongeRng &operator=(const SpongeRng &) GOLDILOCKS_DELETE;
 };
+
+/** Sponge-based random-number generator which serves small reads from a ratcheted buffer */
+class BufferedSpongeRng : public Rng {
+private:
+    /** C wrapped object */
+    goldilocks_keccak_buffered_prng_p sp;
+
+public:
+    /** Initialize from block.  Deterministic generators never reseed. */
+    inline BufferedSpongeRng( const Block &in, SpongeRng::Deterministic det ) {
+        goldilocks_spongerng_buffered_init_from_buffer(sp,in.data(),in.size(),(int)det);
+    }
+
+    /** Initialize non-deterministically from /dev/urandom */
+    inline BufferedSpongeRng() /*throw(RngException)*/ {
+        goldilocks_error_t ret = goldilocks_spongerng_buffered_init_from_dev_urandom(sp);
+        if (!goldilocks_successful(ret)) {
+            throw SpongeRng::RngException(errno, "Couldn't load from /dev/urandom");
+        }
+    }
+
+    /** Reseed after this many bytes or seconds; 0 disables a budget. */
+    inline void set_reseed( uint64_t bytes, uint64_t seconds ) GOLDILOCKS_NOEXCEPT {
+        goldilocks_spongerng_buffered_set_reseed(sp,bytes,seconds);
+    }
+
+    /** Throw if any reseed since initialization couldn't read /dev/urandom. */
+    inline void check_reseed() const /*throw(RngException)*/ {
+        if (!goldilocks_successful(goldilocks_spongerng_buffered_reseed_status(sp))) {
+            throw SpongeRng::RngException(sp->reseed_error, "Couldn't reseed from /dev/urandom");
+        }
+    }
+
+    /** Number of times this generator has reseeded. */
+    inline uint64_t reseeds() const GOLDILOCKS_NOEXCEPT { return sp->reseeds; }
+
+    /** Securely destroy by overwriting state. */
+    inline ~BufferedSpongeRng() GOLDILOCKS_NOEXCEPT { goldilocks_spongerng_buffered_destroy(sp); }
+
+    using Rng::read;
+
+    /** Read data to a buffer. */
+    virtual inline void read(Buffer buffer) GOLDILOCKS_NOEXCEPT
+#if __cplusplus >= 201103L
+        final
+#endif
+        { goldilocks_spongerng_buffered_next(sp,buffer.data(),buffer.size()); }
+
+private:
+    BufferedSpongeRng(const BufferedSpongeRng &) GOLDILOCKS_DELETE;
+    BufferedSpongeRng &operator=(const BufferedSpongeRng &) GOLDILOCKS_DELETE;
+};
+
+/** Keyed root of a family of deterministic streams, any block of which can be generated on its own */
+class StreamRngRoot {
+private:
+    /** C wrapped object */
+    goldilocks_keccak_stream_root_p root;
+    friend class StreamRng;
+
+public:
+    /** Initialize from a key */
+    inline explicit StreamRngRoot( const Block &key ) GOLDILOCKS_NOEXCEPT {
+        goldilocks_spongerng_stream_root_init(root,key.data(),key.size());
+    }
+
+    /** Securely destroy by overwriting state. */
+    inline ~StreamRngRoot() GOLDILOCKS_NOEXCEPT { goldilocks_spongerng_stream_root_destroy(root); }
+
+    /** Read bytes of a stream starting at offset, splitting the blocks across a pool */
+    inline void read_at( uint64_t stream, uint64_t offset, Buffer out, goldilocks_pool_s *pool = NULL ) const
+        /*throw(std::bad_alloc)*/ {
+        if (!goldilocks_successful(goldilocks_spongerng_stream_read_at(root,stream,offset,out.data(),out.size(),pool))) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /** Read bytes of a stream starting at offset, splitting the blocks across a pool */
+    inline SecureBuffer read_at( uint64_t stream, uint64_t offset, size_t len, goldilocks_pool_s *pool = NULL ) const
+        /*throw(std::bad_alloc)*/ {
+        SecureBuffer out(len); read_at(stream,offset,out,pool); return out;
+    }
+
+private:
+    StreamRngRoot(const StreamRngRoot &) GOLDILOCKS_DELETE;
+    StreamRngRoot &operator=(const StreamRngRoot &) GOLDILOCKS_DELETE;
+};
+
+/** One stream of a StreamRngRoot, read sequentially */
+class StreamRng : public Rng {
+private:
+    /** C wrapped object */
+    goldilocks_keccak_stream_prng_p sp;
+
+public:
+    /** Open a stream of a root, positioned at offset */
+    inline StreamRng( const StreamRngRoot &root, uint64_t stream, uint64_t offset = 0 ) GOLDILOCKS_NOEXCEPT {
+        goldilocks_spongerng_stream_init(sp,root.root,stream,offset);
+    }
+
+    /** Jump to any position in the stream */
+    inline void seek( uint64_t offset ) GOLDILOCKS_NOEXCEPT {
+        goldilocks_spongerng_stream_seek(sp,offset);
+    }
+
+    /** Securely destroy by overwriting state. */
+    inline ~StreamRng() GOLDILOCKS_NOEXCEPT { goldilocks_spongerng_stream_destroy(sp); }
+
+    using Rng::read;
+
+    /** Read data to a buffer. */
+    virtual inline void read(Buffer buffer) GOLDILOCKS_NOEXCEPT
+#if __cplusplus >= 201103L
+        final
+#endif
+        { goldilocks_spongerng_stream_next(sp,buffer.data(),buffer.size()); }
+
+private:
+    StreamRng(const StreamRng &) GOLDILOCKS_DELETE;
+    StreamRng &operator=(const StreamRng &) GOLDILOCKS_DELETE;
+};
 /**@endcond*/
 
 } /* namespace goldilocks */
@@ -188,6 +188,71 @@ void API_NS(scalar_add) (
     sc_subx(out, out->limb, sc_p, sc_p, chain);
 }
 
+goldilocks_error_t API_NS(scalar_invert_batch) (
+    scalar_p out[],
+    const scalar_p in[],
+    size_t n
+) {
+    /* Montgomery's trick.  Zero inputs are swapped for one, so that they
+     * don't spoil the shared inverse, and zeroed again at the end.
+     * Products of a normal and a Montgomery-form operand come out of
+     * sc_montmul in normal form, which saves most of the conversions.
+     */
+    scalar_p acc, t;
+    mask_t nonzero = -1;
+    size_t i;
+
+    if (n == 0) return GOLDILOCKS_SUCCESS;
+
+    /* out[i] = in[0]*...*in[i-1]*R */
+    sc_montmul(acc, API_NS(scalar_one), sc_r2);
+    for (i=0; i<n; i++) {
+        goldilocks_bool_t zero = API_NS(scalar_eq)(in[i], API_NS(scalar_zero));
+        nonzero &= ~bool_to_mask(zero);
+        API_NS(scalar_copy)(out[i], acc);
+        API_NS(scalar_cond_sel)(t, in[i], API_NS(scalar_one), zero);
+        sc_montmul(t, t, sc_r2);
+        sc_montmul(acc, acc, t);
+    }
+
+    /* acc = 1/(in[0]*...*in[n-1]) */
+    sc_montmul(acc, acc, API_NS(scalar_one));
+    ignore_result( API_NS(scalar_invert)(acc, acc) );
+
+    for (i=n; i--; ) {
+        goldilocks_bool_t zero = API_NS(scalar_eq)(in[i], API_NS(scalar_zero));
+        API_NS(scalar_cond_sel)(t, in[i], API_NS(scalar_one), zero);
+        sc_montmul(t, t, sc_r2);
+        sc_montmul(out[i], out[i], acc);
+        sc_montmul(acc, acc, t);
+        API_NS(scalar_cond_sel)(out[i], out[i], API_NS(scalar_zero), zero);
+    }
+
+    API_NS(scalar_destroy)(acc);
+    API_NS(scalar_destroy)(t);
+    return goldilocks_succeed_if(mask_to_bool(nonzero));
+}
+
+void API_NS(scalar_mul_batch) (
+    scalar_p out[],
+    const scalar_p a[],
+    const scalar_p b[],
+    size_t n
+) {
+    size_t i;
+    for (i=0; i<n; i++) API_NS(scalar_mul)(out[i], a[i], b[i]);
+}
+
+void API_NS(scalar_add_batch) (
+    scalar_p out[],
+    const scalar_p a[],
+    const scalar_p b[],
+    size_t n
+) {
+    size_t i;
+    for (i=0; i<n; i++) API_NS(scalar_add)(out[i], a[i], b[i]);
+}
+
 void
 API_NS(scalar_set_unsigned) (
     scalar_p out,
@@ -254,6 +319,95 @@ void API_NS(scalar_destroy) (
     goldilocks_bzero(scalar, sizeof(scalar_p));
 }
 
+/* Wide reduction.  The order is p = 2^446 - c with c < 2^224, so
+ * x = hi*2^446 + lo is congruent to lo + hi*c.  Three such folds take
+ * a 912-bit input to below 2p.
+ */
+#define SC_FOLD_BITS 446
+#define SC_FOLD_LIMB (SC_FOLD_BITS / WBITS)
+#define SC_FOLD_SHIFT (SC_FOLD_BITS % WBITS)
+#define SC_FOLD_C_LIMBS (256 / WBITS)
+#define SC_WIDE_BYTES 114
+#define SC_BITS_TO_LIMBS(bits) (((bits) + WBITS - 1) / WBITS)
+
+static const goldilocks_word_t sc_fold_c[SC_FOLD_C_LIMBS] = {
+    SC_LIMB(0xdc873d6d54a7bb0d), SC_LIMB(0xde933d8d723a70aa), SC_LIMB(0x3bb124b65129c96f), SC_LIMB(0x000000008335dc16)
+};
+
+/** out = (in mod 2^446) + (in >> 446) * c, in constant time.
+ * The caller sizes nout to hold the result, so partial products
+ * which would land above it are zero and can be skipped.
+ */
+static void sc_fold (
+    goldilocks_word_t *out,
+    unsigned int nout,
+    const goldilocks_word_t *in,
+    unsigned int nin
+) {
+    goldilocks_word_t hi[SC_BITS_TO_LIMBS(8*SC_WIDE_BYTES)];
+    unsigned int i, j, nhi = nin - SC_FOLD_LIMB;
+
+    for (i=0; i<nhi; i++) {
+        hi[i] = in[SC_FOLD_LIMB+i] >> SC_FOLD_SHIFT;
+        if (SC_FOLD_LIMB+i+1 < nin) hi[i] |= in[SC_FOLD_LIMB+i+1] << (WBITS-SC_FOLD_SHIFT);
+    }
+    for (i=0; i<nout; i++) {
+        out[i] = (i < SC_FOLD_LIMB) ? in[i] : 0;
+    }
+    out[SC_FOLD_LIMB] = in[SC_FOLD_LIMB] & (((goldilocks_word_t)1<<SC_FOLD_SHIFT)-1);
+
+    for (i=0; i<nhi && i<nout; i++) {
+        goldilocks_dword_t chain = 0;
+        for (j=0; j<SC_FOLD_C_LIMBS && i+j<nout; j++) {
+            chain += ((goldilocks_dword_t)hi[i])*sc_fold_c[j] + out[i+j];
+            out[i+j] = chain;
+            chain >>= WBITS;
+        }
+        for (; i+j<nout; j++) {
+            chain += out[i+j];
+            out[i+j] = chain;
+            chain >>= WBITS;
+        }
+    }
+    goldilocks_bzero(hi, sizeof(hi));
+}
+
+/** Reduce a little-endian string of at most 114 bytes, e.g. an EdDSA hash
+ * output or a random scalar_random_batch string.  Shorter strings are
+ * zero-extended; the bounds below only get smaller.
+ */
+static void scalar_decode_wide (
+    scalar_p s,
+    const unsigned char *ser,
+    size_t ser_len
+) {
+    /* Bounds: 912 bits -> < 2^691 -> < 2^470 -> < 2^446 + 2^248 < 2p */
+    enum {
+        L0 = SC_BITS_TO_LIMBS(8*SC_WIDE_BYTES),
+        L1 = SC_BITS_TO_LIMBS(691),
+        L2 = SC_BITS_TO_LIMBS(470)
+    };
+    goldilocks_word_t t0[L0], t1[L1], t2[SCALAR_LIMBS];
+    unsigned int i, j, k=0;
+
+    for (i=0; i<L0; i++) {
+        goldilocks_word_t out = 0;
+        for (j=0; j<sizeof(goldilocks_word_t) && k<ser_len; j++,k++) {
+            out |= ((goldilocks_word_t)ser[k])<<(8*j);
+        }
+        t0[i] = out;
+    }
+
+    sc_fold(t1, L1, t0, L0);
+    sc_fold(t0, L2, t1, L1);
+    sc_fold(t2, SCALAR_LIMBS, t0, L2);
+    sc_subx(s, t2, sc_p, sc_p, 0);
+
+    goldilocks_bzero(t0, sizeof(t0));
+    goldilocks_bzero(t1, sizeof(t1));
+    goldilocks_bzero(t2, sizeof(t2));
+}
+
 void API_NS(scalar_decode_long)(
     scalar_p s,
     const unsigned char *ser,
@@ -267,6 +421,12 @@ void API_NS(scalar_decode_long)(
         return;
     }
 
+    if (ser_len > SCALAR_SER_BYTES && ser_len <= SC_WIDE_BYTES) {
+        /* Folding beats the Montgomery chain below for anything it can hold */
+        scalar_decode_wide(s, ser, ser_len);
+        return;
+    }
+
     i = ser_len - (ser_len%SCALAR_SER_BYTES);
     if (i==ser_len) i -= SCALAR_SER_BYTES;
 
@@ -17,6 +17,7 @@
 #define _DEFAULT_SOURCE 1 /* for endian with glibc 2.20 */
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "portable_endian.h"
@@ -86,23 +87,59 @@ void keccakf(kdomain_u state, uint8_t start_round) {
     for (i=0; i<25; i++) a[i] = htole64(a[i]);
 }
 
+/* XOR input into the state.  The state is kept in little-endian byte order,
+ * so whole lanes can be XORed in without caring about host endianness.
+ */
+static inline void xor_into_state (
+    uint8_t *state,
+    const uint8_t *in,
+    size_t len
+) {
+    uint64_t lane, tmp;
+    for (; len && ((uintptr_t)state & 7); len--) *state++ ^= *in++;
+    for (; len >= 8; len -= 8, state += 8, in += 8) {
+        memcpy(&lane, state, 8);
+        memcpy(&tmp, in, 8);
+        lane ^= tmp;
+        memcpy(state, &lane, 8);
+    }
+    for (; len; len--) *state++ ^= *in++;
+}
+
 goldilocks_error_t goldilocks_sha3_update (
     struct goldilocks_keccak_sponge_s * __restrict__ goldilocks_sponge,
     const uint8_t *in,
     size_t len
 ) {
+    const size_t rate = goldilocks_sponge->params->rate;
+    const uint8_t start_round = goldilocks_sponge->params->start_round;
+    uint64_t *lanes = goldilocks_sponge->state->w;
     assert(goldilocks_sponge->params->position < goldilocks_sponge->params->rate);
     assert(goldilocks_sponge->params->rate < sizeof(goldilocks_sponge->state));
     assert(goldilocks_sponge->params->flags == FLAG_ABSORBING);
+    assert(rate % 8 == 0);
     while (len) {
-        size_t cando = goldilocks_sponge->params->rate - goldilocks_sponge->params->position, i;
+        size_t cando = rate - goldilocks_sponge->params->position, i;
         uint8_t* state = &goldilocks_sponge->state->b[goldilocks_sponge->params->position];
-        if (cando > len) {
-            for (i = 0; i < len; i += 1) state[i] ^= in[i];
+
+        if (cando == rate && len >= rate) {
+            /* Bulk absorb: whole blocks, straight from the caller's buffer */
+            do {
+                for (i = 0; i < rate/8; i++) {
+                    uint64_t lane;
+                    memcpy(&lane, &in[8*i], 8);
+                    lanes[i] ^= lane;
+                }
+                keccakf(goldilocks_sponge->state, start_round);
+                len -= rate;
+                in += rate;
+            } while (len >= rate);
+        } else if (cando > len) {
+            xor_into_state(state, in, len);
             goldilocks_sponge->params->position += len;
             break;
         } else {
-            for (i = 0; i < cando; i += 1) state[i] ^= in[i];
+            xor_into_state(state, in, cando);
             dokeccak(goldilocks_sponge);
             len -= cando;
             in += cando;
@@ -117,6 +154,7 @@ goldilocks_error_t goldilocks_sha3_output (
     size_t len
 ) {
     goldilocks_error_t ret = GOLDILOCKS_SUCCESS;
+    const size_t rate = goldilocks_sponge->params->rate;
     assert(goldilocks_sponge->params->position < goldilocks_sponge->params->rate);
     assert(goldilocks_sponge->params->rate < sizeof(goldilocks_sponge->state));
 
@@ -145,7 +183,7 @@ goldilocks_error_t goldilocks_sha3_output (
     }
 
     while (len) {
-        size_t cando = goldilocks_sponge->params->rate - goldilocks_sponge->params->position;
+        size_t cando = rate - goldilocks_sponge->params->position;
         uint8_t* state = &goldilocks_sponge->state->b[goldilocks_sponge->params->position];
         if (cando > len) {
             memcpy(out, state, len);
@@ -153,9 +191,16 @@ goldilocks_error_t goldilocks_sha3_output (
             return ret;
         } else {
             memcpy(out, state, cando);
-            dokeccak(goldilocks_sponge);
             len -= cando;
             out += cando;
+            /* Bulk squeeze: whole blocks, straight into the caller's buffer */
+            while (len >= rate) {
+                keccakf(goldilocks_sponge->state, goldilocks_sponge->params->start_round);
+                memcpy(out, goldilocks_sponge->state->b, rate);
+                len -= rate;
+                out += rate;
+            }
+            dokeccak(goldilocks_sponge);
         }
     }
     return ret;
@@ -208,6 +253,52 @@ goldilocks_error_t goldilocks_sha3_hash (
     return ret;
 }
 
+struct hash_batch {
+    uint8_t *out;
+    size_t outlen;
+    const uint8_t *const *in;
+    const size_t *inlens;
+    const struct goldilocks_kparams_s *params;
+};
+
+/* The sponge lives in the worker's scratch */
+static void hash_batch_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct hash_batch *b = (const struct hash_batch *)ctx;
+    goldilocks_keccak_sponge_s *sponge = (goldilocks_keccak_sponge_s *)scratch;
+    size_t i;
+    for (i=first; i<first+count; i++) {
+        goldilocks_sha3_init(sponge, b->params);
+        goldilocks_sha3_update(sponge, b->in[i], b->inlens[i]);
+        goldilocks_sha3_output(sponge, &b->out[i*b->outlen], b->outlen);
+    }
+}
+
+goldilocks_error_t goldilocks_sha3_hash_batch (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *const in[],
+    const size_t inlens[],
+    size_t n,
+    const struct goldilocks_kparams_s *params,
+    goldilocks_pool_s *pool
+) {
+    struct hash_batch b;
+    goldilocks_error_t ret = GOLDILOCKS_SUCCESS;
+
+    /* goldilocks_sha3_output fails exactly when a fixed-length hash is overread */
+    if (params->max_out != 0xFF && outlen > params->max_out) ret = GOLDILOCKS_FAILURE;
+
+    b.out = out;
+    b.outlen = outlen;
+    b.in = in;
+    b.inlens = inlens;
+    b.params = params;
+    if (!goldilocks_successful(goldilocks_pool_run(pool, n, 0, sizeof(goldilocks_keccak_sponge_s), hash_batch_task, &b))) {
+        ret = GOLDILOCKS_FAILURE;
+    }
+    return ret;
+}
+
 #define DEFSHAKE(n) \
     const struct goldilocks_kparams_s GOLDILOCKS_SHAKE##n##_params_s = \
         { 0, FLAG_ABSORBING, 200-n/4, 0, 0x1f, 0x80, 0xFF, 0xFF };
@@ -216,6 +307,11 @@ goldilocks_error_t goldilocks_sha3_hash (
     const struct goldilocks_kparams_s GOLDILOCKS_SHA3_##n##_params_s = \
         { 0, FLAG_ABSORBING, 200-n/4, 0, 0x06, 0x80, n/8, n/8 };
 
+/* TurboSHAKE runs the last 12 rounds of Keccak-f */
+#define DEFTURBOSHAKE(n) \
+    const struct goldilocks_kparams_s GOLDILOCKS_TURBOSHAKE##n##_params_s = \
+        { 0, FLAG_ABSORBING, 200-n/4, 12, 0x1f, 0x80, 0xFF, 0xFF };
+
 size_t goldilocks_sha3_default_output_bytes (
     const goldilocks_keccak_sponge_p s
 ) {
@@ -238,5 +334,541 @@ DEFSHA3(224)
 DEFSHA3(256)
 DEFSHA3(384)
 DEFSHA3(512)
+DEFTURBOSHAKE(128)
+DEFTURBOSHAKE(256)
+
+goldilocks_error_t goldilocks_turboshake_init (
+    goldilocks_keccak_sponge_p goldilocks_sponge,
+    const struct goldilocks_kparams_s *params,
+    uint8_t domain
+) {
+    goldilocks_sha3_init(goldilocks_sponge, params);
+    if (domain < 0x01 || domain > 0x7F) return GOLDILOCKS_FAILURE;
+    goldilocks_sponge->params->pad = domain;
+    return GOLDILOCKS_SUCCESS;
+}
+
+/* KangarooTwelve, as specified in RFC 9861 */
+#define K12_CHUNK_BYTES 8192
+#define K12_CV_BYTES 32
+#define K12_DOMAIN_SINGLE 0x07
+#define K12_DOMAIN_FINAL  0x06
+#define K12_DOMAIN_LEAF   0x0B
+
+/* Big-endian with no leading zeros, then the number of bytes used. */
+static size_t k12_length_encode (
+    uint8_t out[sizeof(uint64_t)+1],
+    uint64_t x
+) {
+    size_t n = 0, i;
+    uint64_t t;
+    for (t = x; t; t >>= 8) n++;
+    for (i = 0; i < n; i++) out[i] = (uint8_t)(x >> (8*(n-1-i)));
+    out[n] = (uint8_t)n;
+    return n+1;
+}
+
+/* Squeeze the current leaf's chaining value into the final node.  A leaf
+ * whose chaining value was already absorbed by the parallel path is left
+ * zeroized, so it isn't absorbing anymore.
+ */
+static void k12_finish_leaf (
+    goldilocks_kangarootwelve_ctx_p ctx
+) {
+    uint8_t cv[K12_CV_BYTES];
+    if (ctx->leaf->params->flags != FLAG_ABSORBING) return;
+    goldilocks_sha3_output(ctx->leaf, cv, sizeof(cv));
+    goldilocks_sha3_update(ctx->node, cv, sizeof(cv));
+    goldilocks_bzero(cv, sizeof(cv));
+}
+
+void goldilocks_kangarootwelve_init (
+    goldilocks_kangarootwelve_ctx_p ctx
+) {
+    goldilocks_sha3_init(ctx->node, &GOLDILOCKS_TURBOSHAKE128_params_s);
+    goldilocks_sha3_init(ctx->leaf, &GOLDILOCKS_TURBOSHAKE128_params_s);
+    ctx->chunk_bytes = 0;
+    ctx->leaves = 0;
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_update (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    const uint8_t *in,
+    size_t len
+) {
+    if (ctx->node->params->flags != FLAG_ABSORBING) return GOLDILOCKS_FAILURE;
+
+    while (len) {
+        size_t cando;
+        if (ctx->chunk_bytes == K12_CHUNK_BYTES) {
+            /* More data after a full chunk: open a new leaf */
+            if (ctx->leaves == 0) {
+                static const uint8_t marker[8] = { 0x03 };
+                goldilocks_sha3_update(ctx->node, marker, sizeof(marker));
+            } else {
+                k12_finish_leaf(ctx);
+            }
+            goldilocks_turboshake_init(ctx->leaf, &GOLDILOCKS_TURBOSHAKE128_params_s, K12_DOMAIN_LEAF);
+            ctx->leaves++;
+            ctx->chunk_bytes = 0;
+        }
+
+        cando = K12_CHUNK_BYTES - ctx->chunk_bytes;
+        if (cando > len) cando = len;
+        goldilocks_sha3_update(ctx->leaves ? ctx->leaf : ctx->node, in, cando);
+        ctx->chunk_bytes += cando;
+        in += cando;
+        len -= cando;
+    }
+    return GOLDILOCKS_SUCCESS;
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_customize (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    uint8_t enc[sizeof(uint64_t)+1];
+    goldilocks_error_t ret;
+
+    ret = goldilocks_kangarootwelve_update(ctx, custom, custom_len);
+    if (ret != GOLDILOCKS_SUCCESS) return ret;
+    goldilocks_kangarootwelve_update(ctx, enc, k12_length_encode(enc, custom_len));
+
+    if (ctx->leaves == 0) {
+        ctx->node->params->pad = K12_DOMAIN_SINGLE;
+    } else {
+        static const uint8_t terminator[2] = { 0xFF, 0xFF };
+        k12_finish_leaf(ctx);
+        goldilocks_sha3_update(ctx->node, enc, k12_length_encode(enc, ctx->leaves));
+        goldilocks_sha3_update(ctx->node, terminator, sizeof(terminator));
+        ctx->node->params->pad = K12_DOMAIN_FINAL;
+        goldilocks_sha3_destroy(ctx->leaf);
+    }
+
+    /* Switch the final node to squeezing */
+    return goldilocks_sha3_output(ctx->node, NULL, 0);
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_output (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    uint8_t * __restrict__ out,
+    size_t len
+) {
+    if (ctx->node->params->flags == FLAG_ABSORBING) {
+        goldilocks_kangarootwelve_customize(ctx, NULL, 0);
+    }
+    return goldilocks_sha3_output(ctx->node, out, len);
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_final (
+    goldilocks_kangarootwelve_ctx_p ctx,
+    uint8_t * __restrict__ out,
+    size_t len
+) {
+    goldilocks_error_t ret = goldilocks_kangarootwelve_output(ctx, out, len);
+    goldilocks_kangarootwelve_init(ctx);
+    return ret;
+}
+
+void goldilocks_kangarootwelve_destroy (
+    goldilocks_kangarootwelve_ctx_p ctx
+) {
+    goldilocks_bzero(ctx, sizeof(goldilocks_kangarootwelve_ctx_p));
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_hash (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    goldilocks_kangarootwelve_ctx_p ctx;
+    goldilocks_error_t ret;
+    goldilocks_kangarootwelve_init(ctx);
+    goldilocks_kangarootwelve_update(ctx, in, inlen);
+    goldilocks_kangarootwelve_customize(ctx, custom, custom_len);
+    ret = goldilocks_kangarootwelve_output(ctx, out, outlen);
+    goldilocks_kangarootwelve_destroy(ctx);
+    return ret;
+}
+
+/* Tree hashing: leaves are hashed on a pool's threads, and their
+ * chaining values are absorbed into the final node in order.
+ */
+struct tree_leaves {
+    const uint8_t *in;
+    size_t inlen, leaf_bytes, cv_bytes;
+    struct goldilocks_kparams_s params;
+    uint8_t *cvs;
+};
+
+/* Leaf i is in[i*leaf_bytes, (i+1)*leaf_bytes), cut short at inlen. */
+static void tree_hash_leaf (
+    const struct tree_leaves *leaves,
+    size_t i,
+    uint8_t *cv
+) {
+    goldilocks_keccak_sponge_p sponge;
+    size_t off = i * leaves->leaf_bytes, len = leaves->inlen - off;
+    if (len > leaves->leaf_bytes) len = leaves->leaf_bytes;
+    goldilocks_sha3_init(sponge, &leaves->params);
+    goldilocks_sha3_update(sponge, &leaves->in[off], len);
+    goldilocks_sha3_output(sponge, cv, leaves->cv_bytes);
+    goldilocks_sha3_destroy(sponge);
+}
+
+static void tree_hash_task (
+    void *ctx,
+    size_t first,
+    size_t count,
+    void *scratch
+) {
+    const struct tree_leaves *leaves = (const struct tree_leaves *)ctx;
+    size_t i;
+    (void)scratch;
+    for (i = first; i < first + count; i++) {
+        tree_hash_leaf(leaves, i, &leaves->cvs[i * leaves->cv_bytes]);
+    }
+}
+
+/* Fill leaves->cvs on the pool.  Without a pool of several threads, or if
+ * that fails, leaves->cvs is NULL and the caller hashes the leaves itself.
+ */
+static void tree_hash_leaves (
+    struct tree_leaves *leaves,
+    size_t nleaves,
+    goldilocks_pool_s *pool
+) {
+    leaves->cvs = NULL;
+    if (goldilocks_pool_threads(pool) < 2 || nleaves < 2) return;
+
+    leaves->cvs = (uint8_t *)malloc(nleaves * leaves->cv_bytes);
+    if (leaves->cvs && !goldilocks_successful(
+        goldilocks_pool_run(pool, nleaves, 0, 0, tree_hash_task, leaves)
+    )) {
+        free(leaves->cvs);
+        leaves->cvs = NULL;
+    }
+}
+
+goldilocks_error_t goldilocks_kangarootwelve_hash_parallel (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) {
+    goldilocks_kangarootwelve_ctx_p ctx;
+    struct tree_leaves leaves;
+    static const uint8_t marker[8] = { 0x03 };
+    size_t nleaves, i;
+    goldilocks_error_t ret;
+
+    /* Leaves which lie entirely within the message; the chunk after them
+     * holds at least the customization string's length encoding.
+     */
+    nleaves = (inlen / K12_CHUNK_BYTES) ? inlen / K12_CHUNK_BYTES - 1 : 0;
+    leaves.in = &in[K12_CHUNK_BYTES];
+    leaves.inlen = nleaves * K12_CHUNK_BYTES;
+    leaves.leaf_bytes = K12_CHUNK_BYTES;
+    leaves.cv_bytes = K12_CV_BYTES;
+    leaves.params = GOLDILOCKS_TURBOSHAKE128_params_s;
+    leaves.params.pad = K12_DOMAIN_LEAF;
+    tree_hash_leaves(&leaves, nleaves, pool);
+    if (leaves.cvs == NULL) {
+        return goldilocks_kangarootwelve_hash(out, outlen, in, inlen, custom, custom_len);
+    }
+
+    /* Replay the sequential absorption, with the leaves already done */
+    goldilocks_kangarootwelve_init(ctx);
+    goldilocks_sha3_update(ctx->node, in, K12_CHUNK_BYTES);
+    goldilocks_sha3_update(ctx->node, marker, sizeof(marker));
+    for (i = 0; i < nleaves; i++) {
+        goldilocks_sha3_update(ctx->node, &leaves.cvs[i * K12_CV_BYTES], K12_CV_BYTES);
+    }
+    goldilocks_sha3_destroy(ctx->leaf);
+    ctx->leaves = nleaves;
+    ctx->chunk_bytes = K12_CHUNK_BYTES;
+
+    goldilocks_kangarootwelve_update(ctx, &in[(nleaves+1) * K12_CHUNK_BYTES], inlen - (nleaves+1) * K12_CHUNK_BYTES);
+    goldilocks_kangarootwelve_customize(ctx, custom, custom_len);
+    ret = goldilocks_kangarootwelve_output(ctx, out, outlen);
+
+    goldilocks_kangarootwelve_destroy(ctx);
+    goldilocks_bzero(leaves.cvs, nleaves * K12_CV_BYTES);
+    free(leaves.cvs);
+    return ret;
+}
+
+/* SP 800-185 encodings */
+size_t sp800_185_left_encode (
+    uint8_t out[sizeof(uint64_t)+1],
+    uint64_t x
+) {
+    size_t n = 1, i;
+    uint64_t t;
+    for (t = x >> 8; t; t >>= 8) n++;
+    out[0] = (uint8_t)n;
+    for (i = 0; i < n; i++) out[i+1] = (uint8_t)(x >> (8*(n-1-i)));
+    return n+1;
+}
+
+static size_t sp800_185_right_encode (
+    uint8_t out[sizeof(uint64_t)+1],
+    uint64_t x
+) {
+    size_t n = 1, i;
+    uint64_t t;
+    for (t = x >> 8; t; t >>= 8) n++;
+    for (i = 0; i < n; i++) out[i] = (uint8_t)(x >> (8*(n-1-i)));
+    out[n] = (uint8_t)n;
+    return n+1;
+}
+
+static void sp800_185_encode_string (
+    goldilocks_keccak_sponge_p sponge,
+    const uint8_t *str,
+    size_t len
+) {
+    uint8_t enc[sizeof(uint64_t)+1];
+    goldilocks_sha3_update(sponge, enc, sp800_185_left_encode(enc, (uint64_t)len * 8));
+    goldilocks_sha3_update(sponge, str, len);
+}
+
+/* cSHAKE: SHAKE if both strings are empty, otherwise the strings are
+ * absorbed in a block of their own and the domain byte changes.
+ */
+static void cshake_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *name,
+    size_t name_len,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    uint8_t enc[sizeof(uint64_t)+1];
+    goldilocks_sha3_init(sponge, params);
+    if (name_len == 0 && custom_len == 0) return;
+
+    sponge->params->pad = 0x04;
+    goldilocks_sha3_update(sponge, enc, sp800_185_left_encode(enc, sponge->params->rate));
+    sp800_185_encode_string(sponge, name, name_len);
+    sp800_185_encode_string(sponge, custom, custom_len);
+    /* bytepad: zeros to the end of the block leave the state unchanged */
+    if (sponge->params->position) dokeccak(sponge);
+}
+
+void sp800_185_kmac_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *key,
+    size_t key_len,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    static const uint8_t name[] = "KMAC";
+    uint8_t enc[sizeof(uint64_t)+1];
+    cshake_init(sponge, params, name, sizeof(name)-1, custom, custom_len);
+    goldilocks_sha3_update(sponge, enc, sp800_185_left_encode(enc, sponge->params->rate));
+    sp800_185_encode_string(sponge, key, key_len);
+    if (sponge->params->position) dokeccak(sponge);
+}
+
+void goldilocks_cshake_init (
+    goldilocks_keccak_sponge_p sponge,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *name,
+    size_t name_len,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    cshake_init(sponge, params, name, name_len, custom, custom_len);
+}
+
+void goldilocks_kmac_key_init (
+    goldilocks_kmac_key_p prepared,
+    const struct goldilocks_kparams_s *params,
+    const uint8_t *key,
+    size_t key_len,
+    const uint8_t *custom,
+    size_t custom_len
+) {
+    sp800_185_kmac_init(prepared->keyed, params, key, key_len, custom, custom_len);
+}
+
+void goldilocks_kmac_key_destroy (
+    goldilocks_kmac_key_p prepared
+) {
+    goldilocks_sha3_destroy(prepared->keyed);
+}
+
+void goldilocks_kmac_init (
+    goldilocks_keccak_sponge_p sponge,
+    const goldilocks_kmac_key_p prepared
+) {
+    memcpy(sponge, prepared->keyed, sizeof(goldilocks_keccak_sponge_p));
+}
+
+goldilocks_error_t goldilocks_kmac_output (
+    goldilocks_keccak_sponge_p sponge,
+    uint8_t * __restrict__ out,
+    size_t outlen
+) {
+    uint8_t enc[sizeof(uint64_t)+1];
+    if (sponge->params->flags != FLAG_ABSORBING) return GOLDILOCKS_FAILURE;
+    goldilocks_sha3_update(sponge, enc, sp800_185_right_encode(enc, (uint64_t)outlen * 8));
+    return goldilocks_sha3_output(sponge, out, outlen);
+}
+
+void goldilocks_kmac_xof_output (
+    goldilocks_keccak_sponge_p sponge,
+    uint8_t * __restrict__ out,
+    size_t outlen
+) {
+    uint8_t enc[sizeof(uint64_t)+1];
+    if (sponge->params->flags == FLAG_ABSORBING) {
+        goldilocks_sha3_update(sponge, enc, sp800_185_right_encode(enc, 0));
+    }
+    goldilocks_sha3_output(sponge, out, outlen);
+}
+
+void goldilocks_kmac (
+    uint8_t *out,
+    size_t outlen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) {
+    goldilocks_keccak_sponge_p sponge;
+    goldilocks_kmac_init(sponge, prepared);
+    goldilocks_sha3_update(sponge, in, inlen);
+    goldilocks_kmac_output(sponge, out, outlen);
+    goldilocks_sha3_destroy(sponge);
+}
+
+void goldilocks_kmac_xof (
+    uint8_t *out,
+    size_t outlen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) {
+    goldilocks_keccak_sponge_p sponge;
+    goldilocks_kmac_init(sponge, prepared);
+    goldilocks_sha3_update(sponge, in, inlen);
+    goldilocks_kmac_xof_output(sponge, out, outlen);
+    goldilocks_sha3_destroy(sponge);
+}
+
+goldilocks_error_t goldilocks_kmac_verify (
+    const uint8_t *tag,
+    size_t taglen,
+    const goldilocks_kmac_key_p prepared,
+    const uint8_t *in,
+    size_t inlen
+) {
+    goldilocks_keccak_sponge_p sponge;
+    uint8_t enc[sizeof(uint64_t)+1], expected[64];
+    goldilocks_bool_t ok = taglen ? GOLDILOCKS_TRUE : GOLDILOCKS_FALSE;
+    size_t n;
+
+    goldilocks_kmac_init(sponge, prepared);
+    goldilocks_sha3_update(sponge, in, inlen);
+    goldilocks_sha3_update(sponge, enc, sp800_185_right_encode(enc, (uint64_t)taglen * 8));
+
+    /* Compare a chunk at a time, so any tag length works without allocating */
+    for (; taglen; taglen -= n, tag += n) {
+        n = (taglen < sizeof(expected)) ? taglen : sizeof(expected);
+        goldilocks_sha3_output(sponge, expected, n);
+        ok &= goldilocks_memeq(expected, tag, n);
+    }
+    goldilocks_sha3_destroy(sponge);
+    goldilocks_bzero(expected, sizeof(expected));
+    return goldilocks_succeed_if(ok);
+}
+
+#define PARALLELHASH256_CV_BYTES 64
+
+static goldilocks_error_t parallelhash256 (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    size_t block_size,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool,
+    int xof
+) {
+    static const uint8_t name[] = "ParallelHash";
+    goldilocks_keccak_sponge_p sponge;
+    struct tree_leaves leaves;
+    uint8_t enc[sizeof(uint64_t)+1];
+    size_t nleaves, i;
+    goldilocks_error_t ret;
+
+    if (block_size == 0) return GOLDILOCKS_FAILURE;
+    nleaves = inlen / block_size + (inlen % block_size != 0);
+
+    leaves.in = in;
+    leaves.inlen = inlen;
+    leaves.leaf_bytes = block_size;
+    leaves.cv_bytes = PARALLELHASH256_CV_BYTES;
+    leaves.params = GOLDILOCKS_SHAKE256_params_s;
+    tree_hash_leaves(&leaves, nleaves, pool);
+
+    cshake_init(sponge, &GOLDILOCKS_SHAKE256_params_s, name, sizeof(name)-1, custom, custom_len);
+    goldilocks_sha3_update(sponge, enc, sp800_185_left_encode(enc, block_size));
+    for (i = 0; i < nleaves; i++) {
+        if (leaves.cvs) {
+            goldilocks_sha3_update(sponge, &leaves.cvs[i * PARALLELHASH256_CV_BYTES], PARALLELHASH256_CV_BYTES);
+        } else {
+            uint8_t cv[PARALLELHASH256_CV_BYTES];
+            tree_hash_leaf(&leaves, i, cv);
+            goldilocks_sha3_update(sponge, cv, sizeof(cv));
+        }
+    }
+    goldilocks_sha3_update(sponge, enc, sp800_185_right_encode(enc, nleaves));
+    goldilocks_sha3_update(sponge, enc, sp800_185_right_encode(enc, xof ? 0 : (uint64_t)outlen * 8));
+    ret = goldilocks_sha3_output(sponge, out, outlen);
+
+    goldilocks_sha3_destroy(sponge);
+    if (leaves.cvs) {
+        goldilocks_bzero(leaves.cvs, nleaves * PARALLELHASH256_CV_BYTES);
+        free(leaves.cvs);
+    }
+    return ret;
+}
+
+goldilocks_error_t goldilocks_parallelhash256 (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    size_t block_size,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) {
+    return parallelhash256(out, outlen, in, inlen, block_size, custom, custom_len, pool, 0);
+}
+
+goldilocks_error_t goldilocks_parallelhash256_xof (
+    uint8_t *out,
+    size_t outlen,
+    const uint8_t *in,
+    size_t inlen,
+    size_t block_size,
+    const uint8_t *custom,
+    size_t custom_len,
+    goldilocks_pool_s *pool
+) {
+    return parallelhash256(out, outlen, in, inlen, block_size, custom, custom_len, pool, 1);
+}
 
 /* FUTURE: Keyak instances, etc */
@@ -15,6 +15,7 @@
 #include <assert.h>
 #include <stdint.h>
 #include <string.h>
+#include <errno.h>
 
 #include "keccak_internal.h"
 #include <goldilocks/spongerng.h>
@@ -25,6 +26,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+/* for the buffered and per-thread generators */
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
 /** Get entropy from a CPU, preferably in the form of RDRAND, but possibly instead from RDTSC. */
 static void get_cpu_entropy(uint8_t *entropy, size_t len) {
 # if (defined(__i386__) || defined(__x86_64__))
@@ -182,3 +188,338 @@ goldilocks_error_t goldilocks_spongerng_init_from_dev_urandom (
 ) {
     return goldilocks_spongerng_init_from_file(goldilocks_sponge, "/dev/urandom", 64, 0);
 }
+
+/* Bumped in the child on every fork, so buffered generators can tell they were copied. */
+static volatile uint64_t fork_generation = 0;
+static pthread_once_t buffered_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_rng_key;
+static int thread_rng_key_ok = 0;
+
+static void note_fork(void) {
+    fork_generation++;
+}
+
+static void thread_rng_free(void *doomed) {
+    goldilocks_spongerng_buffered_destroy((goldilocks_keccak_buffered_prng_s *)doomed);
+    free(doomed);
+}
+
+static void buffered_setup(void) {
+    pthread_atfork(NULL, NULL, note_fork);
+    thread_rng_key_ok = !pthread_key_create(&thread_rng_key, thread_rng_free);
+}
+
+static void buffered_reset(
+    goldilocks_keccak_buffered_prng_p prng,
+    int deterministic
+) {
+    pthread_once(&buffered_once, buffered_setup);
+    goldilocks_bzero(prng->buffer, sizeof(prng->buffer));
+    prng->position = sizeof(prng->buffer);
+    prng->reseed_bytes = GOLDILOCKS_SPONGERNG_RESEED_BYTES;
+    prng->reseed_seconds = GOLDILOCKS_SPONGERNG_RESEED_SECONDS;
+    prng->since_reseed = 0;
+    prng->last_reseed = time(NULL);
+    prng->fork_generation = fork_generation;
+    prng->reseeds = 0;
+    prng->reseed_error = 0;
+    prng->deterministic = deterministic;
+}
+
+/**
+ * Stir in fresh entropy, and something unique to this process in case /dev/urandom is gone.
+ * If /dev/urandom can't be read, the sponge is still secret; remember the errno so the
+ * caller can find out that it isn't getting fresh entropy.
+ */
+static goldilocks_error_t buffered_reseed(goldilocks_keccak_buffered_prng_p prng) {
+    uint8_t seed[48] = {0};
+    uint64_t pid = getpid(), now = time(NULL);
+    goldilocks_error_t ret = GOLDILOCKS_FAILURE;
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0) {
+        prng->reseed_error = errno;
+    } else {
+        ssize_t red = read(fd, seed, 32);
+        if (red == 32) {
+            ret = GOLDILOCKS_SUCCESS;
+        } else {
+            prng->reseed_error = (red < 0) ? errno : EIO;
+        }
+        close(fd);
+    }
+    memcpy(&seed[32], &pid, sizeof(pid));
+    memcpy(&seed[40], &now, sizeof(now));
+    goldilocks_spongerng_stir(prng->rng, seed, sizeof(seed));
+    goldilocks_bzero(seed, sizeof(seed));
+
+    prng->since_reseed = 0;
+    prng->last_reseed = now;
+    prng->fork_generation = fork_generation;
+    prng->reseeds++;
+    return ret;
+}
+
+/** Generate one block of output, reseeding first if a budget has run out. */
+static void buffered_generate(
+    goldilocks_keccak_buffered_prng_p prng,
+    uint8_t *out
+) {
+    if (!prng->deterministic) {
+        uint64_t now = time(NULL);
+        if (prng->fork_generation != fork_generation
+            || (prng->reseed_bytes && prng->since_reseed >= prng->reseed_bytes)
+            || (prng->reseed_seconds && (now < prng->last_reseed
+                                         || now - prng->last_reseed >= prng->reseed_seconds))
+        ) {
+            (void)buffered_reseed(prng); /* failures are recorded in prng->reseed_error */
+        }
+    }
+    /* goldilocks_spongerng_next stirs afterwards, so the sponge ratchets on each block */
+    goldilocks_spongerng_next(prng->rng, out, GOLDILOCKS_SPONGERNG_BUFFER_BYTES);
+    prng->since_reseed += GOLDILOCKS_SPONGERNG_BUFFER_BYTES;
+}
+
+void goldilocks_spongerng_buffered_init_from_buffer (
+    goldilocks_keccak_buffered_prng_p prng,
+    const uint8_t * __restrict__ in,
+    size_t len,
+    int deterministic
+) {
+    goldilocks_spongerng_init_from_buffer(prng->rng, in, len, deterministic);
+    buffered_reset(prng, deterministic);
+}
+
+goldilocks_error_t goldilocks_spongerng_buffered_init_from_dev_urandom (
+    goldilocks_keccak_buffered_prng_p prng
+) {
+    goldilocks_error_t ret = goldilocks_spongerng_init_from_dev_urandom(prng->rng);
+    buffered_reset(prng, 0);
+    return ret;
+}
+
+void goldilocks_spongerng_buffered_set_reseed (
+    goldilocks_keccak_buffered_prng_p prng,
+    uint64_t reseed_bytes,
+    uint64_t reseed_seconds
+) {
+    prng->reseed_bytes = reseed_bytes;
+    prng->reseed_seconds = reseed_seconds;
+}
+
+goldilocks_error_t goldilocks_spongerng_buffered_reseed_status (
+    const goldilocks_keccak_buffered_prng_p prng
+) {
+    return prng->reseed_error ? GOLDILOCKS_FAILURE : GOLDILOCKS_SUCCESS;
+}
+
+void goldilocks_spongerng_buffered_next (
+    goldilocks_keccak_buffered_prng_p prng,
+    uint8_t * __restrict__ out,
+    size_t len
+) {
+    size_t take;
+
+    if (!prng->deterministic && prng->fork_generation != fork_generation) {
+        /* Our parent has the same buffer: throw it away */
+        goldilocks_bzero(prng->buffer, sizeof(prng->buffer));
+        prng->position = sizeof(prng->buffer);
+    }
+
+    while (len) {
+        if (prng->position == sizeof(prng->buffer)) {
+            if (len >= sizeof(prng->buffer)) {
+                /* Whole blocks go straight to the caller */
+                buffered_generate(prng, out);
+                out += sizeof(prng->buffer);
+                len -= sizeof(prng->buffer);
+                continue;
+            }
+            buffered_generate(prng, prng->buffer);
+            prng->position = 0;
+        }
+
+        take = sizeof(prng->buffer) - prng->position;
+        if (take > len) take = len;
+        memcpy(out, &prng->buffer[prng->position], take);
+        goldilocks_bzero(&prng->buffer[prng->position], take);
+        prng->position += take;
+        out += take;
+        len -= take;
+    }
+}
+
+void goldilocks_spongerng_buffered_destroy (
+    goldilocks_keccak_buffered_prng_p doomed
+) {
+    goldilocks_spongerng_destroy(doomed->rng);
+    goldilocks_bzero(doomed, sizeof(*doomed));
+}
+
+goldilocks_error_t goldilocks_spongerng_thread_next (
+    uint8_t * __restrict__ out,
+    size_t len
+) {
+    goldilocks_keccak_buffered_prng_s *prng;
+
+    pthread_once(&buffered_once, buffered_setup);
+    if (!thread_rng_key_ok) return GOLDILOCKS_FAILURE;
+
+    prng = (goldilocks_keccak_buffered_prng_s *)pthread_getspecific(thread_rng_key);
+    if (!prng) {
+        prng = (goldilocks_keccak_buffered_prng_s *)malloc(sizeof(*prng));
+        if (!prng) return GOLDILOCKS_FAILURE;
+        if (!goldilocks_successful(goldilocks_spongerng_buffered_init_from_dev_urandom(prng))
+            || pthread_setspecific(thread_rng_key, prng)
+        ) {
+            thread_rng_free(prng);
+            return GOLDILOCKS_FAILURE;
+        }
+    }
+
+    /* Only report reseed failures from this call */
+    prng->reseed_error = 0;
+    goldilocks_spongerng_buffered_next(prng, out, len);
+    return goldilocks_spongerng_buffered_reseed_status(prng);
+}
+
+/* Deterministic streams: KMACXOF256 of (stream, block) under the root key */
+static const uint8_t stream_custom[] = "goldilocks stream rng";
+
+void goldilocks_spongerng_stream_root_init (
+    goldilocks_keccak_stream_root_p root,
+    const uint8_t *key,
+    size_t key_len
+) {
+    sp800_185_kmac_init(root->keyed, &GOLDILOCKS_SHAKE256_params_s,
+        key, key_len, stream_custom, sizeof(stream_custom)-1);
+}
+
+void goldilocks_spongerng_stream_root_destroy (
+    goldilocks_keccak_stream_root_p doomed
+) {
+    goldilocks_sha3_destroy(doomed->keyed);
+}
+
+/** Start squeezing a block, skipping its first skip bytes. */
+static void stream_block_start (
+    goldilocks_keccak_sponge_p sponge,
+    const goldilocks_keccak_stream_root_p root,
+    uint64_t stream,
+    uint64_t block,
+    size_t skip
+) {
+    uint8_t enc[2*(sizeof(uint64_t)+1)+2], junk[64];
+    size_t n = sp800_185_left_encode(enc, stream);
+    n += sp800_185_left_encode(&enc[n], block);
+    enc[n++] = 0; /* right_encode(0): arbitrary-length output */
+    enc[n++] = 1;
+
+    memcpy(sponge, root->keyed, sizeof(goldilocks_keccak_sponge_p));
+    goldilocks_sha3_update(sponge, enc, n);
+    for (; skip > sizeof(junk); skip -= sizeof(junk)) {
+        goldilocks_sha3_output(sponge, junk, sizeof(junk));
+    }
+    goldilocks_sha3_output(sponge, junk, skip);
+    goldilocks_bzero(junk, sizeof(junk));
+}
+
+struct stream_read {
+    const goldilocks_keccak_stream_root_s *root;
+    uint64_t stream, offset;
+    uint8_t *out;
+    size_t len;
+};
+
+/* Item i is the i'th block that the read touches; the sponge lives in scratch */
+static void stream_read_task (void *ctx, size_t first, size_t count, void *scratch) {
+    const struct stream_read *r = (const struct stream_read *)ctx;
+    goldilocks_keccak_sponge_s *sponge = (goldilocks_keccak_sponge_s *)scratch;
+    const uint64_t B = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+    const uint64_t first_block = r->offset / B;
+    size_t i;
+
+    for (i=first; i<first+count; i++) {
+        uint64_t start = (first_block + i) * B, end = start + B;
+        if (start < r->offset) start = r->offset;
+        if (end > r->offset + r->len) end = r->offset + r->len;
+        stream_block_start(sponge, r->root, r->stream, first_block + i, start % B);
+        goldilocks_sha3_output(sponge, &r->out[start - r->offset], end - start);
+    }
+}
+
+goldilocks_error_t goldilocks_spongerng_stream_read_at (
+    const goldilocks_keccak_stream_root_p root,
+    uint64_t stream,
+    uint64_t offset,
+    uint8_t * __restrict__ out,
+    size_t len,
+    goldilocks_pool_s *pool
+) {
+    const uint64_t B = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+    struct stream_read r;
+    size_t nblocks;
+    if (!len) return GOLDILOCKS_SUCCESS;
+
+    r.root = root;
+    r.stream = stream;
+    r.offset = offset;
+    r.out = out;
+    r.len = len;
+    nblocks = (offset + len - 1) / B - offset / B + 1;
+
+    if (nblocks == 1) {
+        /* Nothing to split, so don't wake the pool or allocate for it */
+        goldilocks_keccak_sponge_p sponge;
+        stream_read_task(&r, 0, 1, sponge);
+        goldilocks_sha3_destroy(sponge);
+        return GOLDILOCKS_SUCCESS;
+    }
+    return goldilocks_pool_run(pool, nblocks, 1,
+        sizeof(goldilocks_keccak_sponge_s), stream_read_task, &r);
+}
+
+void goldilocks_spongerng_stream_init (
+    goldilocks_keccak_stream_prng_p prng,
+    const goldilocks_keccak_stream_root_p root,
+    uint64_t stream,
+    uint64_t offset
+) {
+    prng->root[0] = root[0];
+    prng->stream = stream;
+    goldilocks_spongerng_stream_seek(prng, offset);
+}
+
+void goldilocks_spongerng_stream_seek (
+    goldilocks_keccak_stream_prng_p prng,
+    uint64_t offset
+) {
+    const uint64_t B = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+    stream_block_start(prng->block, prng->root, prng->stream, offset / B, offset % B);
+    prng->next_block = offset / B + 1;
+    prng->remaining = B - offset % B;
+}
+
+void goldilocks_spongerng_stream_next (
+    goldilocks_keccak_stream_prng_p prng,
+    uint8_t * __restrict__ out,
+    size_t len
+) {
+    while (len) {
+        size_t take;
+        if (!prng->remaining) {
+            stream_block_start(prng->block, prng->root, prng->stream, prng->next_block++, 0);
+            prng->remaining = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+        }
+        take = (len < prng->remaining) ? len : prng->remaining;
+        goldilocks_sha3_output(prng->block, out, take);
+        out += take;
+        len -= take;
+        prng->remaining -= take;
+    }
+}
+
+void goldilocks_spongerng_stream_destroy (
+    goldilocks_keccak_stream_prng_p doomed
+) {
+    goldilocks_bzero(doomed, sizeof(*doomed));
+}
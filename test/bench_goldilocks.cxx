@@ -14,6 +14,7 @@
 #include <goldilocks/spongerng.hxx>
 #include <goldilocks/eddsa.hxx>
 #include <stdio.h>
+#include <unistd.h>
 #include <sys/time.h>
 #include <assert.h>
 #include <stdint.h>
@@ -150,6 +151,7 @@ template<typename Group> struct Benches {
 typedef typename Group::Scalar Scalar;
 typedef typename Group::Point Point;
 typedef typename Group::Precomputed Precomputed;
+typedef typename Group::PreparedPoint PreparedPoint;
 
 static void cfrg() {
     SpongeRng rng(Block("bench_cfrg_crypto"),SpongeRng::DETERMINISTIC);
@@ -164,6 +166,8 @@ static void cfrg() {
     SecureBuffer sig;
     for (Benchmark b("EdDSA keygen"); b.iter(); ) { priv = e1; }
     for (Benchmark b("EdDSA sign"); b.iter(); ) { sig = priv.sign(Block(NULL,0)); }
+    FixedArrayBuffer<EdDSA<Group>::PrivateKey::SIG_BYTES> fsig;
+    for (Benchmark b("EdDSA sign_into"); b.iter(); ) { priv.sign_into(fsig,Block(NULL,0)); }
     pub = priv;
     for (Benchmark b("EdDSA verify"); b.iter(); ) { pub.verify(sig,Block(NULL,0)); }
 }
@@ -185,20 +189,89 @@ static void micro() {
     for (Benchmark b("Scalar add", 1000); b.iter(); ) { s+=t; }
     for (Benchmark b("Scalar times", 100); b.iter(); ) { s*=t; }
     for (Benchmark b("Scalar inv", 1); b.iter(); ) { s.inverse(); }
+    {
+        Scalar in[64], out[64];
+        Scalar::random_batch(rng, in, 64);
+        for (Benchmark b("Scalar inv batch x64", 1); b.iter(); ) { ignore_result(Scalar::invert_batch(out, in, 64)); }
+    }
+    for (Benchmark b("Scalar random"); b.iter(); ) { Scalar r(rng); }
+    {
+        SecureBuffer wide = rng.read(2*Scalar::SER_BYTES+2), wide2 = rng.read(2*Scalar::SER_BYTES+3);
+        for (Benchmark b("Scalar decode 114B"); b.iter(); ) { s = Scalar(wide); }
+        for (Benchmark b("Scalar decode 115B"); b.iter(); ) { s = Scalar(wide2); }
+    }
+    {
+        Scalar batch[32];
+        for (Benchmark b("Scalar random batch x32"); b.iter(); ) { Scalar::random_batch(rng, batch, 32); }
+    }
     for (Benchmark b("Point add", 100); b.iter(); ) { p += q; }
+    {
+        PreparedPoint pq(q);
+        for (Benchmark b("Point add prepared", 100); b.iter(); ) { p += pq; }
+    }
     for (Benchmark b("Point double", 100); b.iter(); ) { p.double_in_place(); }
+    {
+        Point batch[64];
+        Point::random_batch(rng, batch, 64);
+        for (Benchmark b("Point += x64", 10); b.iter(); ) { Point r; for (int i=0; i<64; i++) r += batch[i]; }
+        for (Benchmark b("Point sum x64", 10); b.iter(); ) { Point::sum(batch, 64); }
+        for (Benchmark b("Point normalize x64"); b.iter(); ) { Point::normalize_batch(batch, 64); }
+    }
     for (Benchmark b("Point scalarmul"); b.iter(); ) { p * s; }
     for (Benchmark b("Point encode"); b.iter(); ) { ep = p.serialize(); }
     for (Benchmark b("Point decode"); b.iter(); ) { p = Point(ep); }
+    {
+        Point batch[32];
+        SecureBuffer encs(32*Point::SER_BYTES);
+        for (int i=0; i<32; i++) memcpy(&encs[i*Point::SER_BYTES], ep.data(), Point::SER_BYTES);
+        for (Benchmark b("Point decode batch x32"); b.iter(); ) { ignore_result(Point::decode_batch(batch, encs)); }
+    }
     for (Benchmark b("Point create/destroy"); b.iter(); ) { Point r; }
     for (Benchmark b("Point hash nonuniform"); b.iter(); ) { Point::from_hash(ep); }
     for (Benchmark b("Point hash uniform"); b.iter(); ) { Point::from_hash(ep2); }
+    {
+        Point batch[32];
+        for (Benchmark b("Point random batch x32"); b.iter(); ) { Point::random_batch(rng, batch, 32); }
+    }
     for (Benchmark b("Point unhash nonuniform"); b.iter(); ) { ignore_result(p.invert_elligator(ep,0)); }
     for (Benchmark b("Point unhash uniform"); b.iter(); ) { ignore_result(p.invert_elligator(ep2,0)); }
     for (Benchmark b("Point steg"); b.iter(); ) { p.steg_encode(rng); }
+    {
+        Point batch[32];
+        Point::random_batch(rng, batch, 32);
+        for (Benchmark b("Point steg batch x32"); b.iter(); ) { Point::steg_encode_batch(rng, batch, 32); }
+    }
     for (Benchmark b("Point double scalarmul"); b.iter(); ) { Point::double_scalarmul(p,s,q,t); }
     for (Benchmark b("Point dual scalarmul"); b.iter(); ) { p.dual_scalarmul(p,q,s,t); }
     for (Benchmark b("Point precmp scalarmul"); b.iter(); ) { pBase * s; }
+    {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "/tmp/goldilocks_bench_pre.%d", (int)getpid());
+        Precomputed pq(q);
+        pq.save(filename);
+        for (Benchmark b("Precomputed file map"); b.iter(); ) { typename Group::MappedPrecomputed m(filename); }
+        unlink(filename);
+    }
+    for (Benchmark b("Precompute"); b.iter(); ) { Precomputed pq(q); }
+    {
+        Point bases[8];
+        Precomputed tables[8];
+        Point::random_batch(rng, bases, 8);
+        for (Benchmark b("Precompute batch x8"); b.iter(); ) { Precomputed::precompute_batch(tables, bases, 8); }
+
+        /* How many fixed-base multiplications a table must serve to pay for itself */
+        const int N = 20;
+        double t0 = now();
+        for (int i=0; i<N; i++) { Precomputed pq(q); }
+        double t1 = now();
+        for (int i=0; i<N; i++) { p * s; }
+        double t2 = now();
+        for (int i=0; i<N; i++) { tables[0] * s; }
+        double t3 = now();
+        if (t2-t1 > t3-t2) {
+            printf("Precompute break-even:    %.1f scalarmuls\n", (t1-t0) / ((t2-t1) - (t3-t2)));
+        }
+    }
     for (Benchmark b("Point double scalarmul_v"); b.iter(); ) {
         s = Scalar(rng);
         t = Scalar(rng);
@@ -223,10 +296,28 @@ int main(int argc, char **argv) {
         SHAKE<128> shake1;
         SHAKE<256> shake2;
         SHA3<512> sha5;
+        TurboSHAKE<128> tshake1;
+        KangarooTwelve k12;
         unsigned char b1024[1024] = {1};
         for (Benchmark b("SHAKE128 1kiB", 30); b.iter(); ) { shake1 += Buffer(b1024,1024); }
         for (Benchmark b("SHAKE256 1kiB", 30); b.iter(); ) { shake2 += Buffer(b1024,1024); }
         for (Benchmark b("SHA3-512 1kiB", 30); b.iter(); ) { sha5 += Buffer(b1024,1024); }
+        for (Benchmark b("TurboSHAKE128 1kiB", 30); b.iter(); ) { tshake1 += Buffer(b1024,1024); }
+        for (Benchmark b("K12 1kiB", 30); b.iter(); ) { k12 += Buffer(b1024,1024); }
+
+        BufferedSpongeRng brng(Block("micro-benchmarks"),SpongeRng::DETERMINISTIC);
+        unsigned char b16[16];
+        for (Benchmark b("SpongeRng 16B"); b.iter(); ) { rng.read(Buffer(b16,16)); }
+        for (Benchmark b("Buffered SpongeRng 16B"); b.iter(); ) { brng.read(Buffer(b16,16)); }
+        StreamRngRoot sroot(Block("micro-benchmarks"));
+        StreamRng srng(sroot, 0);
+        for (Benchmark b("Stream RNG 16B"); b.iter(); ) { srng.read(Buffer(b16,16)); }
+
+        KmacKey<256> kmac(Block(b1024,32));
+        for (Benchmark b("KMAC256 64B new key"); b.iter(); ) {
+            KmacKey<256> fresh(Block(b1024,32)); fresh.mac(Block(b1024,64));
+        }
+        for (Benchmark b("KMAC256 64B prepared"); b.iter(); ) { kmac.mac(Block(b1024,64)); }
 
         run_for_all_curves<Micro>();
     }
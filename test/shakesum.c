@@ -5,72 +5,446 @@
  *   Copyright (c) 2015 Cryptography Research, Inc.  \n
  *   Released under the MIT License.  See LICENSE.txt for license information.
  * @author Mike Hamburg
- * @brief SHA3 utility, to be combined with test vectors eventually...
+ * @brief SHA3 / SHAKE / K12 checksum utility, in the style of sha256sum.
  */
 
+#define _POSIX_C_SOURCE 200809L /* for mmap, posix_fadvise, getline */
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
 #include <goldilocks/shake.h>
 
+/* Large reads, so that hashing isn't syscall-bound on pipes and odd files */
+#define READ_BUFFER_BYTES (1<<20)
+
+enum algo_kind { KIND_SPONGE, KIND_K12, KIND_PARALLELHASH, KIND_PARALLELHASH_XOF };
+
+struct algo {
+    const char *name;
+    enum algo_kind kind;
+    const struct goldilocks_kparams_s *params;
+    size_t default_len, max_len;
+};
+
+static const struct algo algos[] = {
+    { "shake256",           KIND_SPONGE, &GOLDILOCKS_SHAKE256_params_s,      512, 0 },
+    { "shake128",           KIND_SPONGE, &GOLDILOCKS_SHAKE128_params_s,      512, 0 },
+    { "sha3-224",           KIND_SPONGE, &GOLDILOCKS_SHA3_224_params_s,   224/8, 224/8 },
+    { "sha3-256",           KIND_SPONGE, &GOLDILOCKS_SHA3_256_params_s,   256/8, 256/8 },
+    { "sha3-384",           KIND_SPONGE, &GOLDILOCKS_SHA3_384_params_s,   384/8, 384/8 },
+    { "sha3-512",           KIND_SPONGE, &GOLDILOCKS_SHA3_512_params_s,   512/8, 512/8 },
+    { "turboshake128",      KIND_SPONGE, &GOLDILOCKS_TURBOSHAKE128_params_s, 512, 0 },
+    { "turboshake256",      KIND_SPONGE, &GOLDILOCKS_TURBOSHAKE256_params_s, 512, 0 },
+    { "k12",                KIND_K12,             NULL,                   512, 0 },
+    { "parallelhash256",    KIND_PARALLELHASH,    NULL,                   512, 0 },
+    { "parallelhashxof256", KIND_PARALLELHASH_XOF, NULL,                  512, 0 }
+};
+
+#define PARALLELHASH_BLOCK_BYTES 8192
+
+struct job {
+    const char *path;
+    unsigned char *digest;   /* output, or expected output in --check mode */
+    size_t digest_len;
+    unsigned long long bytes;
+    int error;               /* errno, or -1 for a malformed --check line */
+    int mismatch;
+};
+
+struct work {
+    const struct algo *algo;
+    struct job *jobs;
+    size_t njobs, next;
+    unsigned int tree_threads;
+    int check;
+    pthread_mutex_t lock;
+};
+
 static void usage() {
+    size_t i;
     fprintf(
         stderr,
-        "goldilocks_shakesum [shake256|shake128|sha3-224|sha3-384|sha3-512] < infile > outfile\n"
+        "usage: goldilocks_shakesum [--algo name] [--length bytes] [--threads n] [--stats] [file ...]\n"
+        "       goldilocks_shakesum [--algo name] [--threads n] [--stats] --check sumfile\n"
+        "       goldilocks_shakesum name < infile > outfile\n"
+        "With no files, or when a file is -, read standard input.\n"
+        "Algorithms:"
     );
+    for (i=0; i<sizeof(algos)/sizeof(algos[0]); i++) fprintf(stderr, " %s", algos[i].name);
+    fprintf(stderr, "\n");
 }
 
-int main(int argc, char **argv) {
-    (void)argc; (void)argv;
+static const struct algo *find_algo(const char *name) {
+    size_t i;
+    for (i=0; i<sizeof(algos)/sizeof(algos[0]); i++) {
+        if (!strcasecmp(name, algos[i].name)) return &algos[i];
+    }
+    return NULL;
+}
 
+static double now(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+/* Hash a buffer which is entirely in memory. */
+static void hash_buffer(
+    const struct algo *algo,
+    goldilocks_pool_s *pool,
+    unsigned char *out,
+    size_t outlen,
+    const unsigned char *data,
+    size_t len
+) {
+    goldilocks_keccak_sponge_p sponge;
+    switch (algo->kind) {
+    case KIND_SPONGE:
+        goldilocks_sha3_init(sponge, algo->params);
+        goldilocks_sha3_update(sponge, data, len);
+        goldilocks_sha3_output(sponge, out, outlen);
+        goldilocks_sha3_destroy(sponge);
+        break;
+    case KIND_K12:
+        goldilocks_kangarootwelve_hash_parallel(out, outlen, data, len, NULL, 0, pool);
+        break;
+    case KIND_PARALLELHASH:
+        goldilocks_parallelhash256(out, outlen, data, len, PARALLELHASH_BLOCK_BYTES, NULL, 0, pool);
+        break;
+    case KIND_PARALLELHASH_XOF:
+        goldilocks_parallelhash256_xof(out, outlen, data, len, PARALLELHASH_BLOCK_BYTES, NULL, 0, pool);
+        break;
+    }
+}
+
+/* Hash a pipe or other unmappable file.  Returns 0 or an errno. */
+static int hash_stream(
+    const struct algo *algo,
+    goldilocks_pool_s *pool,
+    int fd,
+    unsigned char *out,
+    size_t outlen,
+    unsigned long long *bytes
+) {
     goldilocks_keccak_sponge_p sponge;
-    unsigned char buf[1024];
-
-    unsigned int outlen = 512;
-    goldilocks_shake256_gen_init(sponge);
-
-    /* Sloppy.  Real utility would parse --algo, --size ... */
-    if (argc > 1) {
-        if (!strcmp(argv[1], "shake256") || !strcmp(argv[1], "SHAKE256")) {
-            outlen = 512;
-            goldilocks_shake256_gen_init(sponge);
-        } else if (!strcmp(argv[1], "shake128") || !strcmp(argv[1], "SHAKE128")) {
-            outlen = 512;
-            goldilocks_shake128_gen_init(sponge);
-        } else if (!strcmp(argv[1], "sha3-224") || !strcmp(argv[1], "SHA3-224")) {
-            outlen = 224/8;
-            goldilocks_sha3_224_gen_init(sponge);
-        } else if (!strcmp(argv[1], "sha3-256") || !strcmp(argv[1], "SHA3-256")) {
-            outlen = 256/8;
-            goldilocks_sha3_256_gen_init(sponge);
-        } else if (!strcmp(argv[1], "sha3-384") || !strcmp(argv[1], "SHA3-384")) {
-            outlen = 384/8;
-            goldilocks_sha3_384_gen_init(sponge);
-        } else if (!strcmp(argv[1], "sha3-512") || !strcmp(argv[1], "SHA3-512")) {
-            outlen = 512/8;
-            goldilocks_sha3_512_gen_init(sponge);
+    goldilocks_kangarootwelve_ctx_p k12;
+    size_t cap = READ_BUFFER_BYTES, have = 0;
+    unsigned char *buf = malloc(cap), *bigger;
+    int whole = (algo->kind == KIND_PARALLELHASH || algo->kind == KIND_PARALLELHASH_XOF);
+    ssize_t red;
+
+    if (!buf) return ENOMEM;
+    if (algo->kind == KIND_SPONGE) goldilocks_sha3_init(sponge, algo->params);
+    if (algo->kind == KIND_K12) goldilocks_kangarootwelve_init(k12);
+
+    for (;;) {
+        if (whole && have == cap) {
+            /* ParallelHash wants the whole message: keep growing */
+            bigger = realloc(buf, cap *= 2);
+            if (!bigger) { free(buf); return ENOMEM; }
+            buf = bigger;
+        }
+        red = read(fd, buf + have, cap - have);
+        if (red < 0 && errno == EINTR) continue;
+        if (red < 0) { free(buf); return errno; }
+        if (red == 0) break;
+        *bytes += red;
+        if (whole) {
+            have += red;
+        } else if (algo->kind == KIND_K12) {
+            goldilocks_kangarootwelve_update(k12, buf, red);
+        } else {
+            goldilocks_sha3_update(sponge, buf, red);
+        }
+    }
+
+    if (whole) {
+        hash_buffer(algo, pool, out, outlen, buf, have);
+    } else if (algo->kind == KIND_K12) {
+        goldilocks_kangarootwelve_output(k12, out, outlen);
+        goldilocks_kangarootwelve_destroy(k12);
+    } else {
+        goldilocks_sha3_output(sponge, out, outlen);
+        goldilocks_sha3_destroy(sponge);
+    }
+    free(buf);
+    return 0;
+}
+
+/* Hash one file, mapping it if we can.  Returns 0 or an errno. */
+static int hash_file(
+    const struct algo *algo,
+    goldilocks_pool_s *pool,
+    struct job *job
+) {
+    struct stat st;
+    int fd, ret, is_stdin = !strcmp(job->path, "-");
+
+    if (is_stdin) {
+        fd = 0;
+    } else {
+        do fd = open(job->path, O_RDONLY); while (fd < 0 && errno == EINTR);
+        if (fd < 0) return errno;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0 && (size_t)st.st_size == (unsigned long long)st.st_size) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            hash_buffer(algo, pool, job->digest, job->digest_len, map, st.st_size);
+            job->bytes = st.st_size;
+            munmap(map, st.st_size);
+            if (!is_stdin) close(fd);
+            return 0;
+        }
+    }
+
+    /* Leave stdin open, since "-" may be named more than once */
+    ret = hash_stream(algo, pool, fd, job->digest, job->digest_len, &job->bytes);
+    if (!is_stdin) close(fd);
+    return ret;
+}
+
+static void *worker(void *arg) {
+    struct work *work = (struct work *)arg;
+    unsigned char *expected = NULL;
+    struct job *job;
+    /* Each file worker keeps its own pool for the tree hashes, so the
+     * leaf threads are started once rather than for every file.
+     */
+    goldilocks_pool_s *pool = (work->tree_threads > 1) ? goldilocks_pool_create(work->tree_threads) : NULL;
+
+    for (;;) {
+        pthread_mutex_lock(&work->lock);
+        job = (work->next < work->njobs) ? &work->jobs[work->next++] : NULL;
+        pthread_mutex_unlock(&work->lock);
+        if (!job) break;
+        if (job->error) continue;
+
+        if (work->check) {
+            free(expected);
+            expected = malloc(job->digest_len);
+            if (!expected) { job->error = ENOMEM; continue; }
+            memcpy(expected, job->digest, job->digest_len);
+        }
+        job->error = hash_file(work->algo, pool, job);
+        if (work->check && !job->error) {
+            job->mismatch = memcmp(expected, job->digest, job->digest_len) != 0;
+        }
+    }
+    free(expected);
+    goldilocks_pool_destroy(pool);
+    return NULL;
+}
+
+static int parse_hex(unsigned char *out, const char *hex, size_t len) {
+    size_t i;
+    for (i=0; i<len; i++) {
+        unsigned int byte;
+        if (sscanf(&hex[2*i], "%2x", &byte) != 1) return -1;
+        out[i] = byte;
+    }
+    return 0;
+}
+
+static void free_check_jobs(struct job *jobs, size_t njobs) {
+    size_t i;
+    for (i=0; i<njobs; i++) {
+        free(jobs[i].digest);
+        free((char *)jobs[i].path);
+    }
+    free(jobs);
+}
+
+/* Read "hex  path" lines, in the format this tool prints.  Returns NULL,
+ * having said why, if the file can't be read or lists no files. */
+static struct job *read_check_file(const char *path, size_t *njobs) {
+    FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    struct job *jobs = NULL, *bigger;
+    char *line = NULL, *name;
+    size_t linecap = 0, cap = 0, hexlen;
+    ssize_t linelen;
+
+    *njobs = 0;
+    if (!f) {
+        fprintf(stderr, "goldilocks_shakesum: %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    while ((linelen = getline(&line, &linecap, f)) > 0) {
+        struct job *job;
+        while (linelen && (line[linelen-1] == '\n' || line[linelen-1] == '\r')) line[--linelen] = 0;
+        if (!linelen) continue;
+
+        if (*njobs == cap) {
+            bigger = realloc(jobs, (cap = cap ? 2*cap : 16) * sizeof(*jobs));
+            if (!bigger) {
+                errno = ENOMEM;
+                break;
+            }
+            jobs = bigger;
+        }
+        job = &jobs[(*njobs)++];
+        memset(job, 0, sizeof(*job));
+
+        hexlen = strspn(line, "0123456789abcdefABCDEF");
+        name = &line[hexlen];
+        if (hexlen == 0 || hexlen % 2 || name[0] != ' ' || (name[1] != ' ' && name[1] != '*')) {
+            job->error = -1;
+            job->path = strdup(line);
+            continue;
+        }
+        job->path = strdup(name + 2);
+        job->digest_len = hexlen / 2;
+        job->digest = malloc(job->digest_len);
+        if (!job->path || !job->digest || parse_hex(job->digest, line, job->digest_len)) {
+            job->error = -1;
+        }
+    }
+
+    if (!feof(f)) {
+        /* A read error, or out of memory for the list */
+        fprintf(stderr, "goldilocks_shakesum: %s: %s\n", path, strerror(errno));
+        free_check_jobs(jobs, *njobs);
+        jobs = NULL;
+    } else if (!*njobs) {
+        fprintf(stderr, "goldilocks_shakesum: %s: no checksum lines found\n", path);
+    }
+
+    free(line);
+    if (f != stdin) fclose(f);
+    return jobs;
+}
+
+int main(int argc, char **argv) {
+    const struct algo *algo = NULL;
+    const char *check = NULL;
+    struct work work;
+    struct job *jobs;
+    size_t njobs = 0, length = 0, i, j;
+    unsigned int threads = 0, nthreads;
+    int stats = 0, arg, status = 0;
+    unsigned long long total = 0;
+    pthread_t *tids;
+    double start;
+
+    for (arg = 1; arg < argc && argv[arg][0] == '-' && argv[arg][1]; arg++) {
+        if (!strcmp(argv[arg], "--")) { arg++; break; }
+        if (!strcmp(argv[arg], "--stats")) { stats = 1; continue; }
+        if (arg+1 >= argc) { usage(); return 2; }
+        if (!strcmp(argv[arg], "--algo") || !strcmp(argv[arg], "-a")) {
+            algo = find_algo(argv[++arg]);
+            if (!algo) { usage(); return 2; }
+        } else if (!strcmp(argv[arg], "--length") || !strcmp(argv[arg], "-l")) {
+            length = strtoul(argv[++arg], NULL, 0);
+            if (!length) { usage(); return 2; }
+        } else if (!strcmp(argv[arg], "--threads") || !strcmp(argv[arg], "-t")) {
+            threads = strtoul(argv[++arg], NULL, 0);
+        } else if (!strcmp(argv[arg], "--check") || !strcmp(argv[arg], "-c")) {
+            check = argv[++arg];
         } else {
             usage();
             return 2;
         }
     }
 
-    ssize_t red;
-    do {
-        red = read(0, buf, sizeof(buf));
-        if (red>0) {
-            goldilocks_sha3_update(sponge,buf,red);
+    /* Old style: the algorithm as the only argument */
+    if (!algo && arg == argc-1 && find_algo(argv[arg]) && access(argv[arg], F_OK)) {
+        algo = find_algo(argv[arg++]);
+    }
+    if (!algo) algo = &algos[0];
+    if (!length) length = algo->default_len;
+    if (algo->max_len && length > algo->max_len) {
+        fprintf(stderr, "goldilocks_shakesum: %s outputs at most %d bytes\n", algo->name, (int)algo->max_len);
+        return 2;
+    }
+
+    if (check) {
+        if (arg < argc) { usage(); return 2; }
+        jobs = read_check_file(check, &njobs);
+        if (!jobs) return 1;
+        for (i=0; i<njobs; i++) {
+            if (algo->max_len && jobs[i].digest_len > algo->max_len) jobs[i].error = -1;
+        }
+    } else {
+        size_t nfiles = (arg < argc) ? (size_t)(argc - arg) : 1;
+        jobs = calloc(nfiles, sizeof(*jobs));
+        if (!jobs) return 1;
+        for (i=0; i<nfiles; i++) {
+            jobs[i].path = (arg < argc) ? argv[arg+i] : "-";
+            jobs[i].digest_len = length;
+            jobs[i].digest = malloc(length);
+            if (!jobs[i].digest) jobs[i].error = ENOMEM;
         }
-    } while (red>0);
+        njobs = nfiles;
+    }
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    nthreads = (threads < njobs) ? threads : (unsigned int)njobs;
+    if (nthreads == 0) nthreads = 1;
 
-    goldilocks_sha3_output(sponge,buf,outlen);
-    goldilocks_sha3_destroy(sponge);
+    work.algo = algo;
+    work.jobs = jobs;
+    work.njobs = njobs;
+    work.next = 0;
+    work.check = (check != NULL);
+    /* Spare threads go to the tree hashes within each file */
+    work.tree_threads = threads / nthreads;
+    pthread_mutex_init(&work.lock, NULL);
 
-    unsigned i;
-    for (i=0; i<outlen; i++) {
-        printf("%02x", buf[i]);
+    start = now();
+    tids = malloc(nthreads * sizeof(*tids));
+    for (i=1; tids && i<nthreads; i++) {
+        if (pthread_create(&tids[i], NULL, worker, &work)) break;
     }
-    printf("\n");
+    worker(&work);
+    for (j=1; tids && j<i; j++) pthread_join(tids[j], NULL);
+    free(tids);
+    pthread_mutex_destroy(&work.lock);
 
-    return 0;
+    for (i=0; i<njobs; i++) {
+        struct job *job = &jobs[i];
+        total += job->bytes;
+        if (job->error == -1) {
+            fprintf(stderr, "goldilocks_shakesum: %s: improperly formatted line\n", job->path ? job->path : "?");
+            status = 1;
+        } else if (job->error) {
+            fprintf(stderr, "goldilocks_shakesum: %s: %s\n", job->path, strerror(job->error));
+            status = 1;
+        } else if (check) {
+            printf("%s: %s\n", job->path, job->mismatch ? "FAILED" : "OK");
+            if (job->mismatch) status = 1;
+        } else {
+            for (j=0; j<job->digest_len; j++) printf("%02x", job->digest[j]);
+            if (arg < argc) printf("  %s", job->path);
+            printf("\n");
+        }
+        free(job->digest);
+        if (check) free((char *)job->path);
+    }
+    free(jobs);
+
+    if (stats) {
+        double elapsed = now() - start;
+        fprintf(stderr, "%s: %llu bytes in %d file%s, %.3f s, %.1f MiB/s, %d thread%s\n",
+            algo->name, total, (int)njobs, njobs == 1 ? "" : "s", elapsed,
+            elapsed > 0 ? total / elapsed / (1<<20) : 0.0, (int)threads, threads == 1 ? "" : "s");
+    }
+
+    return status;
 }
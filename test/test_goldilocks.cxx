@@ -13,7 +13,9 @@
 #include <goldilocks/spongerng.hxx>
 #include <goldilocks/eddsa.hxx>
 #include <goldilocks/shake.hxx>
+#include <goldilocks/pool.hxx>
 #include <stdio.h>
+#include <unistd.h>
 
 using namespace goldilocks;
 
@@ -59,6 +61,7 @@ typedef typename Group::Scalar Scalar;
 typedef typename Group::Point Point;
 typedef typename Group::DhLadder DhLadder;
 typedef typename Group::Precomputed Precomputed;
+typedef typename Group::PreparedPoint PreparedPoint;
 
 static void print(const char *name, const Scalar &x) {
     unsigned char buffer[Scalar::SER_BYTES];
@@ -183,6 +186,21 @@ static void test_arithmetic() {
             arith_check(test,x,y,z,x*y,xi*yi,"mul consistency");
         }
 
+        /* 57- to 114-byte inputs take a dedicated reduction; check it against
+         * Horner's rule on pieces short enough for the generic path */
+        size_t wlen = (i < 2) ? (i ? 2*Scalar::SER_BYTES+2 : Scalar::SER_BYTES+1)
+            : Scalar::SER_BYTES + 1 + i % (Scalar::SER_BYTES+2);
+        SecureBuffer ww = rng.read(wlen), two_224(Scalar::SER_BYTES/2+1);
+        if (i < 2) memset(ww.data(), 0xff, ww.size());
+        two_224[Scalar::SER_BYTES/2] = 1;
+        Scalar two_448 = Scalar(two_224)*Scalar(two_224), wide = 0;
+        for (size_t top = wlen; top; ) {
+            size_t piece = top % Scalar::SER_BYTES ? top % Scalar::SER_BYTES : Scalar::SER_BYTES;
+            top -= piece;
+            wide = wide*two_448 + Scalar(Block(&ww[top], piece));
+        }
+        arith_check(test,x,y,z,Scalar(ww),wide,"wide decode");
+
         if (i%20) continue;
         if (y!=0) arith_check(test,x,y,z,x*y/y,x,"invert");
         try {
@@ -580,6 +598,13 @@ static void test_eddsa() {
             printf("    Signature validation failed on sig %d\n", i);
         }
 
+        FixedArrayBuffer<EdDSA<Group>::PrivateKey::SIG_BYTES> sig2;
+        priv.sign_into(sig2,message,context);
+        if (!sig2.contents_equal(sig)) {
+            test.fail();
+            printf("    sign_into disagrees with sign on sig %d\n", i);
+        }
+
         /* Test encode_like and torque */
         Point p(rng);
         SecureBuffer p1 = p.mul_by_ratio_and_encode_like_eddsa();
@@ -588,6 +613,12 @@ static void test_eddsa() {
             test.fail();
             printf("    Torque and encode like EdDSA failed\n");
         }
+        Scalar x(message);
+        if (!p.serialize_fixed().contents_equal(p.serialize())
+            || !x.serialize_fixed().contents_equal(x.serialize())) {
+            test.fail();
+            printf("    serialize_fixed disagrees with serialize\n");
+        }
         SecureBuffer p3 = p.mul_by_ratio_and_encode_like_ladder();
         SecureBuffer p4 = p.debugging_torque().mul_by_ratio_and_encode_like_ladder();
         if (!memeq(p3,p4)) {
@@ -597,6 +628,340 @@ static void test_eddsa() {
     }
 }
 
+static void test_steg_batch() {
+    SpongeRng rng(Block("test_steg_batch"),SpongeRng::DETERMINISTIC);
+    Test test("Steg batch");
+    const size_t N = 37; /* more than one block */
+    Point pts[N];
+    Point::random_batch(rng, pts, N);
+    pts[0] = Point::identity();
+
+    /* Batch inversion agrees with one at a time */
+    goldilocks_448_point_p cpts[N];
+    uint32_t hints[N];
+    goldilocks_bool_t successes[N];
+    SecureBuffer hashes = rng.read(N*Point::STEG_BYTES), hashes2 = hashes;
+    for (size_t i=0; i<N; i++) {
+        goldilocks_448_point_copy(cpts[i], pts[i].p);
+        hints[i] = (uint32_t)i;
+    }
+    goldilocks_448_invert_elligator_uniform_batch(hashes.data(), successes, cpts, hints, N);
+    for (size_t i=0; i<N; i++) {
+        goldilocks_error_t ret = goldilocks_448_invert_elligator_uniform(&hashes2[i*Point::STEG_BYTES], cpts[i], hints[i]);
+        if (successes[i] != goldilocks_successful(ret)
+            || (successes[i] && !Block(hashes).slice(i*Point::STEG_BYTES,Point::STEG_BYTES)
+                .contents_equal(Block(hashes2).slice(i*Point::STEG_BYTES,Point::STEG_BYTES)))
+        ) {
+            test.fail();
+            printf("    Batch inverse elligator differs at %d\n", (int)i);
+            break;
+        }
+    }
+
+    /* Steg encodings decode to the right points, and every point is in the histogram */
+    uint64_t histogram[Point::STEG_HISTOGRAM_BINS] = {0}, total = 0;
+    SecureBuffer encoded = Point::steg_encode_batch(rng, pts, N, histogram);
+    for (size_t i=0; i<Point::STEG_HISTOGRAM_BINS; i++) total += histogram[i];
+    if (total != N) {
+        test.fail();
+        printf("    Histogram counts %d points, not %d\n", (int)total, (int)N);
+    }
+
+    goldilocks_keccak_prng_p crng;
+    goldilocks_spongerng_init_from_buffer(crng, Block("test_steg_batch").data(), Block("test_steg_batch").size(), 1);
+    SecureBuffer encoded2(N*Point::STEG_BYTES);
+    goldilocks_448_point_steg_encode_batch(encoded2.data(), cpts, N, crng, NULL);
+    goldilocks_spongerng_destroy(crng);
+
+    for (size_t i=0; i<N; i++) {
+        if (Point::from_hash(Block(encoded).slice(i*Point::STEG_BYTES,Point::STEG_BYTES)) != pts[i]
+            || Point::from_hash(Block(encoded2).slice(i*Point::STEG_BYTES,Point::STEG_BYTES)) != pts[i]
+        ) {
+            test.fail();
+            printf("    Steg batch doesn't decode at %d\n", (int)i);
+            break;
+        }
+    }
+}
+
+static void test_point_sum() {
+    SpongeRng rng(Block("test_point_sum"),SpongeRng::DETERMINISTIC);
+    Test test("Point sum");
+    const size_t N = 150; /* more than one block */
+    Point pts[N], normalized[N];
+    Point::random_batch(rng, pts, N);
+    pts[3] = pts[2]; /* a doubling */
+    pts[5] = Point::identity();
+
+    for (size_t n=0; n<=N; n += (n < 10) ? 1 : 47) {
+        Point expected = Point::identity();
+        for (size_t i=0; i<n; i++) expected += pts[i];
+        if (Point::sum(pts, n) != expected) {
+            test.fail();
+            printf("    Sum of %d points is wrong\n", (int)n);
+        }
+    }
+
+    for (size_t i=0; i<N; i++) normalized[i] = pts[i];
+    Point::normalize_batch(normalized, N);
+    for (size_t i=0; i<N; i++) {
+        if (normalized[i] != pts[i] || !normalized[i].validate()) {
+            test.fail();
+            printf("    Normalizing changed point %d\n", (int)i);
+            break;
+        }
+    }
+}
+
+static void test_prepared_point() {
+    SpongeRng rng(Block("test_prepared_point"),SpongeRng::DETERMINISTIC);
+    Test test("Prepared point");
+
+    for (int i=0; i<NTESTS/10 && test.passing_now; i++) {
+        Point p(rng), q(rng);
+        if (i == 0) q = Point::identity();
+        if (i == 1) q = p;
+        PreparedPoint pq(q);
+
+        Point r = p;
+        r += pq;
+        if (r != p+q || p+pq != p+q || p-pq != p-q) {
+            test.fail();
+            printf("    Prepared add/sub disagree with point add/sub\n");
+        }
+        r -= pq;
+        if (r != p) {
+            test.fail();
+            printf("    Prepared sub didn't undo prepared add\n");
+        }
+    }
+}
+
+static void test_decode_batch() {
+    SpongeRng rng(Block("test_decode_batch"),SpongeRng::DETERMINISTIC);
+    Test test("Decode batch");
+    const size_t N = 21;
+
+    /* A mixture of good encodings, random garbage and the identity */
+    SecureBuffer enc(N*Point::SER_BYTES);
+    for (size_t i=0; i<N; i++) {
+        SecureBuffer one = (i%3 == 1) ? rng.read(Point::SER_BYTES)
+                         : (i == 9) ? Point::identity().serialize() : Point(rng).serialize();
+        memcpy(&enc[i*Point::SER_BYTES], one.data(), Point::SER_BYTES);
+    }
+
+    for (int allow_identity=0; allow_identity<2; allow_identity++) {
+        Point pts[N];
+        bool successes[N];
+        goldilocks_error_t ret = Point::decode_batch(pts, enc, allow_identity, successes);
+        bool all = true;
+        for (size_t i=0; i<N; i++) {
+            Point single;
+            bool ok = goldilocks_successful(single.decode(
+                FixedBlock<Point::SER_BYTES>(&enc[i*Point::SER_BYTES]), allow_identity));
+            all &= ok;
+            if (ok != successes[i] || (ok && single != pts[i]) || (!ok && pts[i] != Point::identity())) {
+                test.fail();
+                printf("    Batch decode differs at %d\n", (int)i);
+            }
+        }
+        if (all != goldilocks_successful(ret)) {
+            test.fail();
+            printf("    Batch decode returned the wrong overall result\n");
+        }
+    }
+}
+
+static void test_invert_batch() {
+    Test test("Scalar invert batch");
+    SpongeRng rng(Block("test_invert_batch"),SpongeRng::DETERMINISTIC);
+    const size_t N = 70; /* spans two C++ blocks */
+    Scalar in[N], out[N];
+    Scalar::random_batch(rng, in, N);
+
+    if (!goldilocks_successful(Scalar::invert_batch(out, in, N))) {
+        test.fail();
+        printf("    Batch inversion of nonzero scalars failed\n");
+    }
+    for (size_t i=0; i<N; i++) {
+        if (out[i] * in[i] != 1) {
+            test.fail();
+            printf("    Wrong inverse at %d\n", (int)i);
+            break;
+        }
+    }
+
+    in[3] = 0;
+    in[N-1] = 0;
+    if (goldilocks_successful(Scalar::invert_batch(out, in, N))) {
+        test.fail();
+        printf("    Batch inversion of zero succeeded\n");
+    }
+    for (size_t i=0; i<N; i++) {
+        if (in[i] == 0 ? out[i] != 0 : out[i] != in[i].inverse()) {
+            test.fail();
+            printf("    Wrong inverse around zeros at %d\n", (int)i);
+            break;
+        }
+    }
+
+    goldilocks_448_scalar_p a[4], b[4], c[4];
+    for (int i=0; i<4; i++) {
+        goldilocks_448_scalar_copy(a[i], in[i].s);
+        goldilocks_448_scalar_copy(b[i], in[i+10].s);
+    }
+    goldilocks_448_scalar_mul_batch(c, a, b, 4);
+    for (int i=0; i<4; i++) if (Scalar(c[i]) != in[i]*in[i+10]) { test.fail(); printf("    Wrong product at %d\n", i); }
+    goldilocks_448_scalar_add_batch(c, a, b, 4);
+    for (int i=0; i<4; i++) if (Scalar(c[i]) != in[i]+in[i+10]) { test.fail(); printf("    Wrong sum at %d\n", i); }
+}
+
+static void test_precompute_batch() {
+    Test test("Precompute batch");
+    SpongeRng rng(Block("test_precompute_batch"),SpongeRng::DETERMINISTIC);
+
+    /* More than one chunk of tables per shared inversion */
+    const int n = 6;
+    Point p[n];
+    Precomputed pre[n];
+    Point::random_batch(rng, p, n);
+    Precomputed::precompute_batch(pre, p, n);
+
+    for (int i=0; i<n; i++) {
+        Scalar s(rng);
+        if (pre[i] * s != p[i] * s || pre[i] * s != Precomputed(p[i]) * s) {
+            test.fail();
+            printf("    Batch table %d gives the wrong product\n", i);
+        }
+    }
+}
+
+static void test_precomputed_file() {
+    Test test("Precomputed file");
+    SpongeRng rng(Block("test_precomputed_file"),SpongeRng::DETERMINISTIC);
+    char filename[64];
+    snprintf(filename, sizeof(filename), "/tmp/goldilocks_test_pre.%d", (int)getpid());
+
+    Point p(rng);
+    Precomputed pre(p);
+    Scalar s(rng);
+    try {
+        pre.save(filename);
+        typename Group::MappedPrecomputed mapped(filename);
+        if (mapped * s != p * s || mapped.table() * s != p * s) {
+            test.fail();
+            printf("    Mapped table gives the wrong product\n");
+        }
+    } catch (CryptoException &) {
+        test.fail();
+        printf("    Couldn't save and map a table\n");
+    }
+
+    /* Corrupt one byte of the table, then truncate the file */
+    FILE *f = fopen(filename, "r+b");
+    if (f) {
+        fseek(f, 1000, SEEK_SET);
+        int c = fgetc(f);
+        fseek(f, 1000, SEEK_SET);
+        fputc(c ^ 1, f);
+        fclose(f);
+    }
+    const goldilocks_448_precomputed_s *table;
+    if (goldilocks_successful(goldilocks_448_precomputed_map(&table, filename)) || table != NULL) {
+        test.fail();
+        printf("    Mapped a corrupted table\n");
+    }
+    if (truncate(filename, 1000) != 0
+        || goldilocks_successful(goldilocks_448_precomputed_map(&table, filename))) {
+        test.fail();
+        printf("    Mapped a truncated table\n");
+    }
+    unlink(filename);
+    if (goldilocks_successful(goldilocks_448_precomputed_map(&table, filename))) {
+        test.fail();
+        printf("    Mapped a missing table\n");
+    }
+}
+
+static void test_random_batch() {
+    Test test("Random batch");
+    const size_t N = 70; /* spans a few blocks */
+    goldilocks_keccak_prng_p crng;
+    SpongeRng rng(Block("test_random_batch"),SpongeRng::DETERMINISTIC);
+    goldilocks_spongerng_init_from_buffer(crng, Block("test_random_batch").data(), Block("test_random_batch").size(), 1);
+
+    goldilocks_448_scalar_p cs[N];
+    Scalar ss[N];
+    goldilocks_448_scalar_random_batch(crng, cs, N);
+    Scalar::random_batch(rng, ss, N);
+    for (size_t i=0; i<N; i++) {
+        if (!goldilocks_448_scalar_eq(cs[i], ss[i].s) || (i && ss[i] == ss[i-1])) {
+            test.fail();
+            printf("    Random scalar batches differ at %d\n", (int)i);
+            break;
+        }
+    }
+
+    goldilocks_448_point_p cp[N];
+    Point pp[N];
+    goldilocks_448_point_random_batch(crng, cp, N);
+    Point::random_batch(rng, pp, N);
+    for (size_t i=0; i<N; i++) {
+        if (!goldilocks_448_point_eq(cp[i], pp[i].p) || !pp[i].validate() || (i && pp[i] == pp[i-1])) {
+            test.fail();
+            printf("    Random point batches differ at %d\n", (int)i);
+            break;
+        }
+    }
+    goldilocks_spongerng_destroy(crng);
+}
+
+static void test_eddsa_cache() {
+    Test test("EdDSA verifier cache");
+    SpongeRng rng(Block("test_eddsa_cache"),SpongeRng::DETERMINISTIC);
+    const int NKEYS = 40;
+    FixedArrayBuffer<GOLDILOCKS_EDDSA_448_PUBLIC_BYTES> pk[NKEYS];
+    FixedArrayBuffer<GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES> sig[NKEYS];
+    SecureBuffer message = rng.read(32);
+
+    for (int i=0; i<NKEYS; i++) {
+        FixedArrayBuffer<GOLDILOCKS_EDDSA_448_PRIVATE_BYTES> sk(rng);
+        goldilocks_ed448_derive_public_key(pk[i].data(), sk.data());
+        goldilocks_ed448_sign(sig[i].data(), sk.data(), pk[i].data(), message.data(), message.size(), 0, NULL, 0);
+    }
+
+    /* One cache that holds everything, and one that has to keep evicting */
+    goldilocks_ed448_verifier_cache_s *caches[2] = {
+        goldilocks_ed448_verifier_cache_create(NKEYS*4),
+        goldilocks_ed448_verifier_cache_create(NKEYS/2)
+    };
+
+    for (int c=0; c<2 && test.passing_now; c++) {
+        for (int round=0; round<4; round++) {
+            for (int i=0; i<NKEYS; i++) {
+                goldilocks_error_t good = goldilocks_ed448_verify_cached(caches[c], sig[i].data(),
+                    pk[i].data(), message.data(), message.size(), 0, NULL, 0);
+                goldilocks_error_t bad = goldilocks_ed448_verify_cached(caches[c], sig[i].data(),
+                    pk[(i+1)%NKEYS].data(), message.data(), message.size(), 0, NULL, 0);
+                if (good != GOLDILOCKS_SUCCESS || bad != GOLDILOCKS_FAILURE) {
+                    test.fail();
+                    printf("    Cached verification gave the wrong answer for key %d\n", i);
+                }
+            }
+        }
+
+        uint64_t hits, misses;
+        goldilocks_ed448_verifier_cache_stats(caches[c], &hits, &misses);
+        if (hits + misses != 8*NKEYS || (c == 0 && misses != NKEYS)) {
+            test.fail();
+            printf("    Cache counted %d hits and %d misses\n", (int)hits, (int)misses);
+        }
+    }
+
+    goldilocks_ed448_verifier_cache_destroy(caches[0]);
+    goldilocks_ed448_verifier_cache_destroy(caches[1]);
+}
+
 /* Thanks Johan Pascal */
 static void test_convert_eddsa_to_x() {
     Test test("ECDH using EdDSA keys");
@@ -659,8 +1024,17 @@ static void run() {
     printf("Testing %s:\n",Group::name());
     test_arithmetic();
     test_elligator();
+    test_invert_batch();
+    test_precompute_batch();
+    test_precomputed_file();
+    test_random_batch();
+    test_point_sum();
+    test_prepared_point();
+    test_decode_batch();
+    test_steg_batch();
     test_ec();
     test_eddsa();
+    test_eddsa_cache();
     test_convert_eddsa_to_x();
     test_cfrg_crypto();
     test_cfrg_vectors();
@@ -679,11 +1053,16 @@ static void test_xof() {
     FixedArrayBuffer<1024> a,b,c;
     rng.read(c);
 
-    T s1, s2;
-    unsigned i;
+    T s1, s2, s3;
+    unsigned i, step;
     for (i=0; i<c.size(); i++) s1.update(c.slice(i,1));
     s2.update(c);
 
+    /* Uneven pieces, so that partial and whole-block paths are mixed */
+    for (i=0, step=1; i<c.size(); i+=step, step=step*2+3) {
+        s3.update(c.slice(i,std::min<size_t>(step,c.size()-i)));
+    }
+
     for (i=0; i<a.size(); i++) s1.output(a.slice(i,1));
     s2.output(b);
 
@@ -691,6 +1070,319 @@ static void test_xof() {
         test.fail();
         printf("    Buffers aren't equal!\n");
     }
+
+    for (i=0, step=5; i<a.size(); i+=step, step=step*3+1) {
+        s3.output(a.slice(i,std::min<size_t>(step,a.size()-i)));
+    }
+    if (!a.contents_equal(b)) {
+        test.fail();
+        printf("    Buffers aren't equal when absorbed and squeezed unevenly!\n");
+    }
+}
+
+/* RFC 9861 test vectors: ptn(n) is the byte pattern 00 01 .. FA repeated */
+static SecureBuffer ptn(size_t n) {
+    SecureBuffer b(n);
+    for (size_t i=0; i<n; i++) b[i] = i % 251;
+    return b;
+}
+
+static void test_kangarootwelve() {
+    Test test("TurboSHAKE and K12");
+    static const struct {
+        size_t msg_len, custom_len;
+        const char *expected;
+    } k12_vectors[] = {
+        { 0, 0, "1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5" },
+        { 17*17*17, 0, "cb552e2ec77d9910701d578b457ddf772c12e322e4ee7fe417f92c758f0d59d0" },
+        { 8192, 0, "48f256f6772f9edfb6a8b661ec92dc93b95ebd05a08a17b39ae3490870c926c3" },
+        { 8192, 8190, "6a7c1b6a5cd0d8c9ca943a4a216cc64604559a2ea45f78570a15253d67ba00ae" }
+    };
+
+    for (unsigned i=0; i<sizeof(k12_vectors)/sizeof(k12_vectors[0]); i++) {
+        SecureBuffer msg = ptn(k12_vectors[i].msg_len), custom = ptn(k12_vectors[i].custom_len);
+        SecureBuffer one = KangarooTwelve::hash(msg, 32, custom);
+
+        /* Same thing, absorbed in uneven pieces */
+        KangarooTwelve k12;
+        for (size_t off=0, step=1; off<msg.size(); off+=step, step=step*3+1) {
+            k12.update(Block(msg).slice(off, std::min(step, msg.size()-off)));
+        }
+        k12.customize(custom);
+        SecureBuffer two = k12.output(32);
+
+        char hex[65];
+        for (unsigned j=0; j<32; j++) sprintf(&hex[2*j], "%02x", one[j]);
+        if (strcmp(hex, k12_vectors[i].expected) || one != two) {
+            test.fail();
+            printf("    K12 test vector %d failed\n", i);
+        }
+    }
+
+    SecureBuffer t1 = TurboSHAKE<128>::hash(ptn(17*17), 32, 0x06);
+    static const uint8_t t1_expected[32] = {
+        0xf6,0x03,0x92,0xc7,0x29,0xdc,0x79,0x28,0xe8,0xb2,0xe3,0x6f,0xed,0x5b,0xff,0x8a,
+        0x5a,0x42,0x75,0xcf,0x37,0x7c,0xa1,0x96,0x48,0x3a,0x8c,0xb6,0xec,0xae,0x8a,0x13
+    };
+    if (!Block(t1).contents_equal(Block(t1_expected, sizeof(t1_expected)))) {
+        test.fail();
+        printf("    TurboSHAKE128 test vector failed\n");
+    }
+}
+
+static void test_sp800_185() {
+    Test test("cSHAKE and KMAC");
+
+    /* NIST SP 800-185 samples: cSHAKE128 #1, cSHAKE256 #3, KMAC128 #1 and #2, KMAC256 #4, KMACXOF256 #4 */
+    static const uint8_t x[4] = { 0x00,0x01,0x02,0x03 };
+    static const uint8_t key[32] = {
+        0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f,
+        0x50,0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f
+    };
+    static const uint8_t cshake128_expected[32] = {
+        0xc1,0xc3,0x69,0x25,0xb6,0x40,0x9a,0x04,0xf1,0xb5,0x04,0xfc,0xbc,0xa9,0xd8,0x2b,
+        0x40,0x17,0x27,0x7c,0xb5,0xed,0x2b,0x20,0x65,0xfc,0x1d,0x38,0x14,0xd5,0xaa,0xf5
+    };
+    static const uint8_t cshake256_expected[64] = {
+        0xd0,0x08,0x82,0x8e,0x2b,0x80,0xac,0x9d,0x22,0x18,0xff,0xee,0x1d,0x07,0x0c,0x48,
+        0xb8,0xe4,0xc8,0x7b,0xff,0x32,0xc9,0x69,0x9d,0x5b,0x68,0x96,0xee,0xe0,0xed,0xd1,
+        0x64,0x02,0x0e,0x2b,0xe0,0x56,0x08,0x58,0xd9,0xc0,0x0c,0x03,0x7e,0x34,0xa9,0x69,
+        0x37,0xc5,0x61,0xa7,0x4c,0x41,0x2b,0xb4,0xc7,0x46,0x46,0x95,0x27,0x28,0x1c,0x8c
+    };
+    static const uint8_t kmac128_expected[2][32] = {{
+        0xe5,0x78,0x0b,0x0d,0x3e,0xa6,0xf7,0xd3,0xa4,0x29,0xc5,0x70,0x6a,0xa4,0x3a,0x00,
+        0xfa,0xdb,0xd7,0xd4,0x96,0x28,0x83,0x9e,0x31,0x87,0x24,0x3f,0x45,0x6e,0xe1,0x4e
+    }, {
+        0x3b,0x1f,0xba,0x96,0x3c,0xd8,0xb0,0xb5,0x9e,0x8c,0x1a,0x6d,0x71,0x88,0x8b,0x71,
+        0x43,0x65,0x1a,0xf8,0xba,0x0a,0x70,0x70,0xc0,0x97,0x9e,0x28,0x11,0x32,0x4a,0xa5
+    }};
+    static const uint8_t kmac256_expected[64] = {
+        0x20,0xc5,0x70,0xc3,0x13,0x46,0xf7,0x03,0xc9,0xac,0x36,0xc6,0x1c,0x03,0xcb,0x64,
+        0xc3,0x97,0x0d,0x0c,0xfc,0x78,0x7e,0x9b,0x79,0x59,0x9d,0x27,0x3a,0x68,0xd2,0xf7,
+        0xf6,0x9d,0x4c,0xc3,0xde,0x9d,0x10,0x4a,0x35,0x16,0x89,0xf2,0x7c,0xf6,0xf5,0x95,
+        0x1f,0x01,0x03,0xf3,0x3f,0x4f,0x24,0x87,0x10,0x24,0xd9,0xc2,0x77,0x73,0xa8,0xdd
+    };
+    static const uint8_t kmacxof256_expected[64] = {
+        0x17,0x55,0x13,0x3f,0x15,0x34,0x75,0x2a,0xad,0x07,0x48,0xf2,0xc7,0x06,0xfb,0x5c,
+        0x78,0x45,0x12,0xca,0xb8,0x35,0xcd,0x15,0x67,0x6b,0x16,0xc0,0xc6,0x64,0x7f,0xa9,
+        0x6f,0xaa,0x7a,0xf6,0x34,0xa0,0xbf,0x8f,0xf6,0xdf,0x39,0x37,0x4f,0xa0,0x0f,0xad,
+        0x9a,0x39,0xe3,0x22,0xa7,0xc9,0x20,0x65,0xa6,0x4e,0xb1,0xfb,0x08,0x01,0xeb,0x2b
+    };
+    const Block msg(x,sizeof(x)), k(key,sizeof(key)), tagged("My Tagged Application");
+
+    if (!Block(cSHAKE<128>::hash(msg, 32, "Email Signature")).contents_equal(Block(cshake128_expected,32))
+        || !Block(cSHAKE<256>::hash(msg, 64, "Email Signature")).contents_equal(Block(cshake256_expected,64))
+    ) {
+        test.fail();
+        printf("    cSHAKE samples failed\n");
+    }
+
+    /* Resetting keeps the customization string */
+    cSHAKE<128> cs("Email Signature");
+    cs += Block("junk");
+    cs.reset();
+    cs += msg;
+    SecureBuffer once = cs.final(32);
+    cs += msg;
+    if (!Block(once).contents_equal(Block(cshake128_expected,32)) || !Block(cs.output(32)).contents_equal(Block(cshake128_expected,32))) {
+        test.fail();
+        printf("    cSHAKE reset lost the customization string\n");
+    }
+
+    KmacKey<128> k128(k), k128t(k, tagged);
+    KmacKey<256> k256(k, tagged);
+    if (!Block(k128.mac(msg)).contents_equal(Block(kmac128_expected[0],32))
+        || !Block(k128t.mac(msg)).contents_equal(Block(kmac128_expected[1],32))
+        || !Block(k256.mac(msg)).contents_equal(Block(kmac256_expected,64))
+        || !Block(k256.mac_xof(msg)).contents_equal(Block(kmacxof256_expected,64))
+    ) {
+        test.fail();
+        printf("    KMAC samples failed\n");
+    }
+
+    /* The prepared key is reused, incrementally and in pieces */
+    for (int i=0; i<3; i++) {
+        KMAC<256> mac(k256), xof(k256);
+        mac << Block(x,1) << Block(x+1,3);
+        xof += msg;
+        SecureBuffer first = xof.output_xof(10), rest = xof.output_xof(54);
+        first.insert(first.end(), rest.begin(), rest.end());
+        if (!Block(mac.output()).contents_equal(Block(kmac256_expected,64)) || !Block(first).contents_equal(Block(kmacxof256_expected,64))) {
+            test.fail();
+            printf("    Incremental KMAC failed\n");
+        }
+        try {
+            mac.output();
+            test.fail();
+            printf("    KMAC output twice\n");
+        } catch (CryptoException&) {}
+    }
+
+    /* Verification, including tags longer than the comparison chunk */
+    SecureBuffer tag = k256.mac(msg, 100);
+    k256.verify(tag, msg);
+    k128.verify(Block(kmac128_expected[0],32), msg);
+    tag[99] ^= 1;
+    const Block bad[] = { tag, Block(kmac128_expected[0],31), Block() };
+    for (unsigned i=0; i<sizeof(bad)/sizeof(bad[0]); i++) {
+        try {
+            if (i) k128.verify(bad[i], msg);
+            else k256.verify(bad[i], msg);
+            test.fail();
+            printf("    KMAC accepted bad tag %d\n", i);
+        } catch (CryptoException&) {}
+    }
+
+    /* Stream RNG blocks are KMACXOF256 of the stream and block indices */
+    StreamRngRoot root(k);
+    KmacKey<256> stream_key(k, "goldilocks stream rng");
+    static const uint8_t index[4] = { 0x01,0x05,0x01,0x02 }; /* stream 5, block 2 */
+    const size_t B = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+    if (root.read_at(5, 2*B, B) != stream_key.mac_xof(Block(index,sizeof(index)), B)) {
+        test.fail();
+        printf("    Stream RNG isn't KMACXOF256\n");
+    }
+}
+
+static void pool_count_task(void *ctx, size_t first, size_t count, void *scratch) {
+    unsigned char *done = (unsigned char *)ctx;
+    (void)scratch;
+    for (size_t i=first; i<first+count; i++) done[i]++;
+}
+
+static void test_pool_startup() {
+    Test test("Thread pool startup");
+    const size_t N = 100;
+
+    /* A job submitted before the workers have first run must still finish */
+    for (int round=0; round<500 && test.passing_now; round++) {
+        unsigned char done[N] = {0};
+        ThreadPool pool(2 + round % 4);
+        if (goldilocks_pool_run(pool.get(), N, 1, 64, pool_count_task, done) != GOLDILOCKS_SUCCESS) {
+            test.fail();
+        }
+        for (size_t i=0; i<N; i++) {
+            if (done[i] != 1) test.fail();
+        }
+        if (!test.passing_now) printf("    Pool job failed in round %d\n", round);
+    }
+}
+
+static void test_pool_batch() {
+    Test test("Thread pool batches");
+    SpongeRng rng(Block("test_pool_batch"),SpongeRng::DETERMINISTIC);
+    const int N = 23;
+    ThreadPool pool(4);
+    goldilocks_pool_s *pools[2] = { NULL, pool.get() };
+
+    uint8_t sk[N][GOLDILOCKS_EDDSA_448_PRIVATE_BYTES], pk[N][GOLDILOCKS_EDDSA_448_PUBLIC_BYTES];
+    uint8_t sig[N][GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES];
+    uint8_t xsk[N][GOLDILOCKS_X448_PRIVATE_BYTES], xpk[N][GOLDILOCKS_X448_PUBLIC_BYTES];
+    uint8_t xss[N][GOLDILOCKS_X448_PUBLIC_BYTES], hash[N][64];
+    SecureBuffer msg[N];
+    const uint8_t *msgs[N];
+    size_t lens[N];
+    for (int i=0; i<N; i++) {
+        rng.read(Buffer(sk[i],sizeof(sk[i])));
+        rng.read(Buffer(xsk[i],sizeof(xsk[i])));
+        msg[i] = rng.read(i*7);
+        msgs[i] = msg[i].data();
+        lens[i] = msg[i].size();
+        goldilocks_ed448_derive_public_key(pk[i], sk[i]);
+        goldilocks_ed448_sign(sig[i], sk[i], pk[i], msgs[i], lens[i], 0, NULL, 0);
+        goldilocks_x448_derive_public_key(xpk[i], xsk[i]);
+    }
+    for (int i=0; i<N; i++) {
+        if (goldilocks_x448(xss[i], xpk[(i+1)%N], xsk[i]) != GOLDILOCKS_SUCCESS) test.fail();
+        goldilocks_sha3_hash(hash[i], 64, msgs[i], lens[i], &GOLDILOCKS_SHAKE256_params_s);
+    }
+
+    for (int p=0; p<2 && test.passing_now; p++) {
+        uint8_t out[N*GOLDILOCKS_EDDSA_448_SIGNATURE_BYTES], bases[N][GOLDILOCKS_X448_PUBLIC_BYTES];
+        goldilocks_bool_t ok[N];
+
+        goldilocks_ed448_derive_public_key_batch(out, sk[0], N, pools[p]);
+        for (int i=0; i<N; i++) {
+            if (memcmp(&out[i*sizeof(pk[i])], pk[i], sizeof(pk[i]))) test.fail();
+        }
+
+        goldilocks_ed448_sign_batch(out, sk[0], pk[0], msgs, lens, N, 0, NULL, 0, pools[p]);
+        if (memcmp(out, sig, sizeof(sig))) test.fail();
+
+        out[(N/2)*sizeof(sig[0]) + 3] ^= 1;
+        goldilocks_error_t ret = goldilocks_ed448_verify_batch(ok, NULL, out, pk[0],
+            msgs, lens, N, 0, NULL, 0, pools[p]);
+        for (int i=0; i<N; i++) {
+            if (ok[i] != (i == N/2 ? GOLDILOCKS_FALSE : GOLDILOCKS_TRUE)) test.fail();
+        }
+        if (ret != GOLDILOCKS_FAILURE) test.fail();
+
+        goldilocks_x448_derive_public_key_batch(out, xsk[0], N, pools[p]);
+        for (int i=0; i<N; i++) {
+            if (memcmp(&out[i*sizeof(xpk[i])], xpk[i], sizeof(xpk[i]))) test.fail();
+            memcpy(bases[i], xpk[(i+1)%N], sizeof(bases[i]));
+        }
+        if (goldilocks_x448_batch(out, ok, bases[0], xsk[0], N, pools[p]) != GOLDILOCKS_SUCCESS) test.fail();
+        for (int i=0; i<N; i++) {
+            if (memcmp(&out[i*sizeof(xss[i])], xss[i], sizeof(xss[i]))) test.fail();
+        }
+
+        if (goldilocks_sha3_hash_batch(out, 64, msgs, lens, N,
+                &GOLDILOCKS_SHAKE256_params_s, pools[p]) != GOLDILOCKS_SUCCESS) test.fail();
+        for (int i=0; i<N; i++) {
+            if (memcmp(&out[i*64], hash[i], 64)) test.fail();
+        }
+
+        if (!test.passing_now) printf("    Batch results differ with %s pool\n", p ? "a" : "no");
+    }
+}
+
+static void test_parallel_hash() {
+    Test test("Parallel tree hashes");
+
+    /* NIST SP 800-185 ParallelHash256 samples 4 and 5 */
+    static const uint8_t x[24] = {
+        0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x10,0x11,0x12,0x13,
+        0x14,0x15,0x16,0x17,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27
+    };
+    static const uint8_t ph_expected[2][64] = {{
+        0xbc,0x1e,0xf1,0x24,0xda,0x34,0x49,0x5e,0x94,0x8e,0xad,0x20,0x7d,0xd9,0x84,0x22,
+        0x35,0xda,0x43,0x2d,0x2b,0xbc,0x54,0xb4,0xc1,0x10,0xe6,0x4c,0x45,0x11,0x05,0x53,
+        0x1b,0x7f,0x2a,0x3e,0x0c,0xe0,0x55,0xc0,0x28,0x05,0xe7,0xc2,0xde,0x1f,0xb7,0x46,
+        0xaf,0x97,0xa1,0xdd,0x01,0xf4,0x3b,0x82,0x4e,0x31,0xb8,0x76,0x12,0x41,0x04,0x29
+    }, {
+        0xcd,0xf1,0x52,0x89,0xb5,0x4f,0x62,0x12,0xb4,0xbc,0x27,0x05,0x28,0xb4,0x95,0x26,
+        0x00,0x6d,0xd9,0xb5,0x4e,0x2b,0x6a,0xdd,0x1e,0xf6,0x90,0x0d,0xda,0x39,0x63,0xbb,
+        0x33,0xa7,0x24,0x91,0xf2,0x36,0x96,0x9c,0xa8,0xaf,0xae,0xa2,0x9c,0x68,0x2d,0x47,
+        0xa3,0x93,0xc0,0x65,0xb3,0x8e,0x29,0xfa,0xe6,0x51,0xa2,0x09,0x1c,0x83,0x31,0x10
+    }};
+    const char *ph_custom[2] = { "", "Parallel Data" };
+
+    ThreadPool pool2(2), pool4(4);
+    goldilocks_pool_s *pools[3] = { NULL, pool2.get(), pool4.get() };
+
+    for (unsigned i=0; i<2; i++) {
+        for (unsigned p=0; p<3; p++) {
+            SecureBuffer out = ParallelHash256::hash(Block(x,sizeof(x)), 64, ph_custom[i], 8, pools[p]);
+            if (!Block(out).contents_equal(Block(ph_expected[i],64))) {
+                test.fail();
+                printf("    ParallelHash256 sample %d failed with %d threads\n", i+4, goldilocks_pool_threads(pools[p]));
+            }
+        }
+    }
+
+    /* K12 tree mode must not depend on the thread count */
+    const size_t sizes[] = { 8192*3, 8192*4+1, 8192*17-5, 100000 };
+    for (unsigned i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+        SecureBuffer msg = ptn(sizes[i]);
+        SecureBuffer one = KangarooTwelve::hash(msg, 32, "custom");
+        for (unsigned p=0; p<3; p++) {
+            if (KangarooTwelve::hash_parallel(msg, 32, "custom", pools[p]) != one) {
+                test.fail();
+                printf("    Parallel K12 of %d bytes failed with %d threads\n", (int)sizes[i], goldilocks_pool_threads(pools[p]));
+            }
+        }
+    }
 }
 
 static void test_rng() {
@@ -739,13 +1431,115 @@ static void test_rng() {
     }
 }
 
+static void test_buffered_rng() {
+    Test test("Buffered RNG");
+    BufferedSpongeRng rng_d1(Block("test_buffered_rng"),SpongeRng::DETERMINISTIC);
+    BufferedSpongeRng rng_d2(Block("test_buffered_rng"),SpongeRng::DETERMINISTIC);
+    BufferedSpongeRng rng_n1, rng_n2;
+
+    /* Deterministic output mustn't depend on how it's split up, across block boundaries too */
+    SecureBuffer whole = rng_d1.read(3*GOLDILOCKS_SPONGERNG_BUFFER_BYTES + 100), pieces;
+    const size_t sizes[] = {1, 7, 8, 32, 57, GOLDILOCKS_SPONGERNG_BUFFER_BYTES, 1000, 2*GOLDILOCKS_SPONGERNG_BUFFER_BYTES};
+    for (size_t i=0; pieces.size() < whole.size(); i = (i+1) % (sizeof(sizes)/sizeof(sizes[0]))) {
+        size_t n = std::min(sizes[i], whole.size() - pieces.size());
+        SecureBuffer piece = rng_d2.read(n);
+        pieces.insert(pieces.end(), piece.begin(), piece.end());
+    }
+    if (whole != pieces) {
+        test.fail();
+        printf("  Deterministic buffered RNG depends on request sizes!\n");
+    }
+
+    /* The first block is drawn on the initial seed, and each later one spends the budget */
+    rng_n1.set_reseed(64, 0);
+    rng_n2.set_reseed(0, 0);
+    rng_d1.set_reseed(64, 0);
+    SecureBuffer out_n1 = rng_n1.read(3*GOLDILOCKS_SPONGERNG_BUFFER_BYTES);
+    SecureBuffer out_n2 = rng_n2.read(3*GOLDILOCKS_SPONGERNG_BUFFER_BYTES);
+    rng_d1.read(3*GOLDILOCKS_SPONGERNG_BUFFER_BYTES);
+    if (rng_n1.reseeds() != 2 || rng_n2.reseeds() != 0 || rng_d1.reseeds() != 0) {
+        test.fail();
+        printf("  Reseeded %d, %d and %d times; expected 2, 0 and 0!\n",
+            (int)rng_n1.reseeds(), (int)rng_n2.reseeds(), (int)rng_d1.reseeds());
+    }
+    if (out_n1 == out_n2) {
+        test.fail();
+        printf("  Nondeterministic buffered RNG matched!\n");
+    }
+    try {
+        rng_n1.check_reseed();
+    } catch (const SpongeRng::RngException &e) {
+        test.fail();
+        printf("  Reseed failed: %s (errno %d)\n", e.what(), e.err_code);
+    }
+
+    uint8_t a[32], b[32];
+    if (!goldilocks_successful(goldilocks_spongerng_thread_next(a, sizeof(a)))
+        || !goldilocks_successful(goldilocks_spongerng_thread_next(b, sizeof(b)))
+        || !memcmp(a, b, sizeof(a))
+    ) {
+        test.fail();
+        printf("  Per-thread RNG failed or repeated itself!\n");
+    }
+}
+
+static void test_stream_rng() {
+    Test test("Stream RNG");
+    const size_t B = GOLDILOCKS_SPONGERNG_STREAM_BLOCK_BYTES;
+    StreamRngRoot root(Block("test_stream_rng")), other(Block("test_stream_rnh"));
+    ThreadPool pool(3);
+
+    /* Sequential reads, split any way, match random access with or without a pool */
+    SecureBuffer whole = root.read_at(5, 0, 3*B + 100);
+    StreamRng rng(root, 5);
+    SecureBuffer pieces;
+    const size_t sizes[] = {1, 7, 64, 1000, B, 57, 2*B};
+    for (size_t i=0; pieces.size() < whole.size(); i = (i+1) % (sizeof(sizes)/sizeof(sizes[0]))) {
+        SecureBuffer piece = rng.read(std::min(sizes[i], whole.size() - pieces.size()));
+        pieces.insert(pieces.end(), piece.begin(), piece.end());
+    }
+    if (whole != pieces || root.read_at(5, 0, whole.size(), pool.get()) != whole) {
+        test.fail();
+        printf("  Stream RNG depends on how it's read!\n");
+    }
+
+    /* Jumps, within and across blocks, forwards and backwards */
+    const size_t offsets[] = {B-5, 1234, 2*B, 17, 3*B+99};
+    for (size_t i=0; i<sizeof(offsets)/sizeof(offsets[0]); i++) {
+        size_t n = std::min((size_t)300, whole.size() - offsets[i]);
+        SecureBuffer expected(whole.begin() + offsets[i], whole.begin() + offsets[i] + n);
+        rng.seek(offsets[i]);
+        if (rng.read(n) != expected || root.read_at(5, offsets[i], n, pool.get()) != expected) {
+            test.fail();
+            printf("  Stream RNG jump to %d failed!\n", (int)offsets[i]);
+        }
+    }
+
+    if (root.read_at(6, 0, 64) == root.read_at(5, 0, 64)
+        || root.read_at(5, B, 64) == root.read_at(5, 0, 64)
+        || other.read_at(5, 0, 64) == root.read_at(5, 0, 64)
+    ) {
+        test.fail();
+        printf("  Stream RNG repeated itself across streams, blocks or keys!\n");
+    }
+}
+
 #include "vectors.inc.cxx"
 
 int main(int argc, char **argv) {
     (void) argc; (void) argv;
     test_rng();
+    test_buffered_rng();
+    test_stream_rng();
     test_xof<SHAKE<128> >();
     test_xof<SHAKE<256> >();
+    test_xof<TurboSHAKE<128> >();
+    test_xof<TurboSHAKE<256> >();
+    test_kangarootwelve();
+    test_parallel_hash();
+    test_sp800_185();
+    test_pool_startup();
+    test_pool_batch();
     printf("\n");
     run_for_all_curves<Tests>();
     if (passing) printf("Passed all tests.\n");